@@ -0,0 +1,1164 @@
+// LinuxǰˣԶ׼ԡҲperf/valgrind
+// : make
+// ÷: connect6 [--size 15|19] [--connect6] [--log ļ] [--profile ļ] [--random-playouts] match <A> <B> [Ծ] [߳] [AIÿ]
+//       connect6 bench [] [ظ]
+//       connect6 [--size 15|19] [--connect6] [--profile ļ] [--random-playouts] analyze <> [AIÿ]
+//       connect6 replay <־ļ> [dump]
+//       connect6 protocol [] [߳]
+//       connect6 [--size 15|19] [--connect6] load <> [߳] [ͻ˼] [p99Ŀ] [ÿ] [AIÿ]
+//       connect6 [--size 15|19] [--connect6] rollout [Ծ] [߳]
+// Զĺ--sizeѡʵĬ15x15--connect6ʹÿӵı׼
+// --logԶĵÿһ׷ӵƶԾ־ʽgamelog.hreplayȡܣ
+// --profileԶĺÿͳдJSONԶĽʱÿĻֱܺͼ
+// --random-playoutsmctsģȫĬϰͷƫõ㣻
+// protocolGomocupPiskvorkЭڱ׼϶ģ̴СSTARTָ
+// loadһģԾ֣ÿܳصĻỰAIβӳ٣
+// rolloutģں˴ӿ´ȫĶԾ֣ͳȺʤʺÿÿľ
+// ׼Եľ15x15ӹ
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <ctype.h>
+#include "engine.h"
+#include "gamelog.h"
+#include "server.h"
+
+// ===== Զ =====
+// ֶķ䵽̲߳нУ˫ִ
+
+// AI棺ִӷŷÿ̴Сһ
+template <int N>
+struct Engine {
+    const char* name;
+    Position (*move)(const typename Connect6<N>::BoardState* bs, ChessType player);
+    StonePair (*pair)(const typename Connect6<N>::BoardState* bs, ChessType player);   // ˫ӹµһ
+};
+
+// ɲμԶĵ棬ڴ˵Ǽǲ޸engineCount
+const int engineCount = 4;
+template <int N>
+const Engine<N> engines[engineCount] = {
+    {"easy", Connect6<N>::easyAIMove, Connect6<N>::easyAIPair},
+    {"medium", Connect6<N>::mediumAIMove, Connect6<N>::mediumAIPair},
+    {"hard", Connect6<N>::hardAIMove, Connect6<N>::hardAIPair},
+    {"mcts", Connect6<N>::mctsAIMove, Connect6<N>::mctsAIPair},
+};
+
+// һ̵߳Ķͳƣ±0ΪA1ΪB
+typedef struct {
+    int wins[2];
+    int draws;
+    long long moves[2];        // ŷ
+    long long thinkUs[2];      // ˼ʱ΢룩
+    ProfileSummary profile[2]; // ͳƵĻ
+} MatchStats;
+
+template <int N>
+const Engine<N>* findEngine(const char* name) {
+    for (int i = 0; i < engineCount; i++) {
+        if (strcmp(engines<N>[i].name, name) == 0) return &engines<N>[i];
+    }
+    return NULL;
+}
+
+GameLogWriter* matchLog = NULL;    // ԶĵĶԾ־NULLʾ¼
+FILE* profileLog = NULL;           // ÿͳƵNULLʾ
+std::mutex profileLock;            // ̹߳profileLogһд
+
+// һͳƣһJSONstoneΪһֵһӵ
+void writeProfile(const char* engine, int size, int stone, const MoveProfile* p) {
+    char fields[1024];
+    profileFormat(p, fields, sizeof(fields));
+    std::lock_guard<std::mutex> guard(profileLock);
+    fprintf(profileLog, "{\"profile\":\"move\",\"engine\":\"%s\",\"size\":%d,\"stone\":%d,%s}\n",
+            engine, size, stone, fields);
+}
+
+// һ֣ڷΪplayers[0]ضԾֽruleModeÿһӻ
+// µμhistorystats*stoneCount˫ÿֵͳƼprofiles
+template <int N>
+GameStatus playGame(const Engine<N>* players[2], long long moves[2], long long thinkUs[2],
+                    int history[][2], MoveStat* stats, int* stoneCount, ProfileSummary* profiles[2]) {
+    typedef Connect6<N> C6;
+    typename C6::BoardState bs;
+    C6::boardReset(&bs);
+    
+    int stones = 0;
+    *stoneCount = 0;
+    while (stones < C6::MAX_MOVES) {
+        ChessType player = stoneOwner(ruleMode, stones);
+        int side = (player == CT_WHITE);
+        
+        Position turn[2];
+        int count = stonesToPlay(ruleMode, stones);
+        MoveProfile profile;
+        profileBegin(&profile);
+        long long start = nowUs();
+        if (count == 2 && stones + 2 <= C6::MAX_MOVES) {
+            StonePair pair = players[side]->pair(&bs, player);
+            turn[0] = pair.first;
+            turn[1] = pair.second;
+        } else {
+            turn[0] = players[side]->move(&bs, player);
+            count = 1;
+        }
+        long long usedUs = nowUs() - start;
+        profileEnd(&profile);
+        summaryAdd(profiles[side], &profile);
+        if (profileLog != NULL) {
+            writeProfile(players[side]->name, N, stones, &profile);
+        }
+        thinkUs[side] += usedUs;
+        moves[side]++;
+        
+        for (int k = 0; k < count; k++) {
+            Position m = turn[k];
+            // Ƿŷи
+            if (m.row < 0 || m.row >= N || m.col < 0 || m.col >= N ||
+                C6::bitboardGet(&bs.bits, m.row, m.col) != CT_EMPTY) {
+                return side ? GS_BLACK_WIN : GS_WHITE_WIN;
+            }
+            bool win = C6::boardCheckWin(&bs, m.row, m.col, player, NULL);
+            C6::boardPlace(&bs, m.row, m.col, player);
+            history[stones][0] = m.row;
+            history[stones][1] = m.col;
+            stats[stones].depth = (k == 0) ? profile.depth : 0;
+            stats[stones].thinkMs = (k == 0) ? (int)(usedUs / 1000) : 0;
+            stones++;
+            *stoneCount = stones;
+            if (win) return side ? GS_WHITE_WIN : GS_BLACK_WIN;
+        }
+    }
+    return GS_DRAW;
+}
+
+// ̣߳ȡԾֱֱȫꣻżAִ
+template <int N>
+void matchWorker(const Engine<N>* a, const Engine<N>* b, int games,
+                 std::atomic<int>* nextGame, MatchStats* stats) {
+    memset(stats, 0, sizeof(MatchStats));
+    int game;
+    while ((game = nextGame->fetch_add(1)) < games) {
+        int black = game % 2;             // ִڵ±
+        const Engine<N>* players[2];
+        long long moves[2] = {0, 0};
+        long long thinkUs[2] = {0, 0};
+        players[0] = black ? b : a;
+        players[1] = black ? a : b;
+        
+        int history[N * N][2];
+        MoveStat moveStats[N * N];
+        int stones;
+        ProfileSummary* profiles[2] = {&stats->profile[black], &stats->profile[black ^ 1]};
+        GameStatus result = playGame(players, moves, thinkUs, history, moveStats, &stones, profiles);
+        if (matchLog != NULL) {
+            // ִӷǼ˳ţ1~4GameModeļ/е//ؿһ
+            int codes[2] = {(int)(players[0] - engines<N>) + 1, (int)(players[1] - engines<N>) + 1};
+            gameLogAppend(matchLog, N, ruleMode, codes, result, history, stones, moveStats);
+        }
+        for (int side = 0; side < 2; side++) {
+            int engine = side ^ black;
+            stats->moves[engine] += moves[side];
+            stats->thinkUs[engine] += thinkUs[side];
+        }
+        if (result == GS_DRAW) {
+            stats->draws++;
+        } else {
+            int winnerSide = (result == GS_BLACK_WIN) ? 0 : 1;
+            stats->wins[winnerSide ^ black]++;
+        }
+    }
+}
+
+// ===== ׼ =====
+// ̶̾棨15x15moveHistoryʽȽӣ{-1, -1}β
+#define BENCH_MAX_MOVES 40
+const int benchCorpus[][BENCH_MAX_MOVES][2] = {
+    {{7, 7}, {8, 6}, {9, 4}, {10, 7}, {8, 7}, {6, 7}, {9, 7}, {9, 6}, {7, 6}, {7, 4}, {8, 5}, {10, 3}, {-1, -1}},
+    {{7, 7}, {9, 5}, {6, 9}, {9, 8}, {9, 7}, {8, 7}, {7, 6}, {7, 8}, {8, 8}, {6, 6}, {9, 6}, {10, 6}, {7, 3}, {7, 5}, {8, 4}, {-1, -1}},
+    {{7, 7}, {8, 8}, {7, 9}, {5, 7}, {7, 8}, {7, 6}, {7, 10}, {7, 11}, {6, 7}, {8, 7}, {8, 9}, {5, 6}, {9, 10}, {10, 11}, {8, 6}, {5, 9}, {5, 4}, {5, 10}, {-1, -1}},
+    {{7, 7}, {5, 5}, {5, 4}, {4, 4}, {6, 6}, {8, 8}, {3, 3}, {7, 6}, {8, 7}, {6, 7}, {5, 8}, {9, 7}, {7, 9}, {7, 8}, {6, 8}, {5, 7}, {5, 6}, {8, 6}, {10, 6}, {3, 6}, {10, 8}, {-1, -1}},
+    {{7, 7}, {8, 8}, {9, 5}, {9, 4}, {6, 8}, {8, 6}, {8, 7}, {6, 7}, {7, 6}, {7, 8}, {9, 8}, {6, 5}, {10, 9}, {11, 10}, {9, 10}, {9, 7}, {6, 4}, {7, 5}, {10, 8}, {11, 8}, {4, 5}, {10, 6}, {11, 5}, {7, 9}, {-1, -1}},
+    {{7, 7}, {9, 7}, {8, 9}, {9, 8}, {9, 6}, {8, 7}, {7, 6}, {7, 8}, {8, 8}, {6, 6}, {9, 9}, {10, 10}, {6, 9}, {10, 9}, {11, 10}, {7, 9}, {10, 7}, {7, 4}, {7, 10}, {8, 11}, {11, 8}, {8, 5}, {12, 9}, {13, 10}, {8, 6}, {11, 6}, {10, 6}, {-1, -1}},
+    {{7, 7}, {5, 6}, {6, 5}, {8, 9}, {6, 7}, {8, 7}, {8, 6}, {6, 8}, {8, 8}, {6, 6}, {7, 6}, {7, 8}, {5, 8}, {8, 5}, {4, 9}, {3, 10}, {9, 6}, {10, 6}, {6, 9}, {4, 7}, {2, 9}, {7, 9}, {5, 9}, {3, 9}, {5, 7}, {5, 10}, {7, 10}, {8, 11}, {8, 10}, {10, 10}, {-1, -1}},
+    {{7, 7}, {9, 5}, {9, 8}, {7, 6}, {8, 7}, {6, 7}, {8, 5}, {8, 6}, {6, 6}, {8, 8}, {9, 6}, {9, 7}, {7, 5}, {5, 5}, {5, 8}, {7, 8}, {5, 6}, {5, 7}, {7, 9}, {7, 4}, {8, 9}, {10, 7}, {11, 9}, {10, 9}, {10, 6}, {6, 9}, {6, 8}, {7, 10}, {10, 8}, {8, 10}, {5, 10}, {5, 9}, {6, 10}, {-1, -1}},
+};
+const int benchCorpusSize = sizeof(benchCorpus) / sizeof(benchCorpus[0]);
+volatile int benchSink;        // 汻⺯ĽֹñŻ
+typedef Connect6<15> Bench;    // ׼ʹõʵ
+
+// ŷаڳ棬ز
+int loadPosition(Bench::BoardState* bs, const int moves[][2]) {
+    Bench::boardReset(bs);
+    int count = 0;
+    while (count < BENCH_MAX_MOVES && moves[count][0] >= 0) {
+        Bench::boardPlace(bs, moves[count][0], moves[count][1], (count % 2) ? CT_WHITE : CT_BLACK);
+        count++;
+    }
+    return count;
+}
+
+int compareLongLong(const void* a, const void* b) {
+    long long x = *(const long long*)a;
+    long long y = *(const long long*)b;
+    return (x > y) - (x < y);
+}
+
+// һԵĺʱֲÿһJSON
+void reportLatency(const char* name, long long* samplesNs, int count, long long calls, long long totalNs) {
+    qsort(samplesNs, count, sizeof(long long), compareLongLong);
+    printf("{\"bench\":\"%s\",\"samples\":%d,\"p50_ns\":%lld,\"p99_ns\":%lld,"
+           "\"max_ns\":%lld,\"throughput_per_s\":%.1f}\n",
+           name, count, samplesNs[(count - 1) / 2], samplesNs[(count - 1) * 99 / 100],
+           samplesNs[count - 1], totalNs > 0 ? calls * 1e9 / totalNs : 0.0);
+}
+
+// ׼ԣڹ̶ϲֳжϡģ⡢еAIAIԼͬ߳µͬһȵʱ
+int runBenchmark(int argc, char* argv[]) {
+    int depth = (argc > 0) ? atoi(argv[0]) : 5;
+    int reps = (argc > 1) ? atoi(argv[1]) : 200;
+    if (depth < 1) depth = 1;
+    if (reps < 1) reps = 1;
+    
+    ttResize(&tt, TT_DEFAULT_MB);
+    searchThreads = 1;
+    searchTimeMs = 1000;
+    
+    long long* samples = new long long[benchCorpusSize * reps];
+    int sampleCount;
+    long long calls, totalNs;
+    Bench::BoardState bs;
+    
+    // checkWinÿǶԾпλ˫жһ
+    sampleCount = 0;
+    calls = totalNs = 0;
+    for (int p = 0; p < benchCorpusSize; p++) {
+        loadPosition(&bs, benchCorpus[p]);
+        for (int r = 0; r < reps; r++) {
+            int hits = 0, probes = 0;
+            long long t0 = nowNs();
+            for (int i = 0; i < Bench::BOARD_SIZE; i++) {
+                for (LineBits empty = Bench::emptyBits(&bs.bits, i); empty; empty &= empty - 1) {
+                    int j = lowestBit(empty);
+                    hits += Bench::bitboardCheckWin(&bs.bits, i, j, CT_BLACK);
+                    hits += Bench::bitboardCheckWin(&bs.bits, i, j, CT_WHITE);
+                    probes += 2;
+                }
+            }
+            long long ns = nowNs() - t0;
+            benchSink += hits;
+            samples[sampleCount++] = ns / probes;
+            calls += probes;
+            totalNs += ns;
+        }
+    }
+    reportLatency("checkWin", samples, sampleCount, calls, totalNs);
+    
+    // ͬжϸĲͻά
+    sampleCount = 0;
+    calls = totalNs = 0;
+    for (int p = 0; p < benchCorpusSize; p++) {
+        loadPosition(&bs, benchCorpus[p]);
+        for (int r = 0; r < reps; r++) {
+            int hits = 0, probes = 0;
+            long long t0 = nowNs();
+            for (int i = 0; i < Bench::BOARD_SIZE; i++) {
+                for (LineBits empty = Bench::emptyBits(&bs.bits, i); empty; empty &= empty - 1) {
+                    int j = lowestBit(empty);
+                    hits += Bench::boardCheckWin(&bs, i, j, CT_BLACK, NULL);
+                    hits += Bench::boardCheckWin(&bs, i, j, CT_WHITE, NULL);
+                    probes += 2;
+                }
+            }
+            long long ns = nowNs() - t0;
+            benchSink += hits;
+            samples[sampleCount++] = ns / probes;
+            calls += probes;
+            totalNs += ns;
+        }
+    }
+    reportLatency("boardCheckWin", samples, sampleCount, calls, totalNs);
+    
+    // ģ⣺ÿǴӾȫһ
+    Rng rng;
+    rngSeed(&rng, 1, 0);
+    long long stones = 0;
+    sampleCount = 0;
+    calls = totalNs = 0;
+    for (int p = 0; p < benchCorpusSize; p++) {
+        int count = loadPosition(&bs, benchCorpus[p]);
+        Bench::PlayoutBoard start, pb;
+        Bench::playoutInit(&start, &bs.bits);
+        for (int r = 0; r < reps; r++) {
+            int length;
+            long long t0 = nowNs();
+            pb = start;
+            benchSink += Bench::randomPlayout(&pb, RULE_ONE_STONE, count, &rng, &length);
+            long long ns = nowNs() - t0;
+            samples[sampleCount++] = ns;
+            stones += length;
+            calls++;
+            totalNs += ns;
+        }
+    }
+    reportLatency("randomPlayout", samples, sampleCount, calls, totalNs);
+    printf("{\"bench\":\"randomPlayout_stones\",\"avg_stones\":%.1f,\"stones_per_s\":%.0f}\n",
+           calls ? (double)stones / calls : 0.0, totalNs > 0 ? stones * 1e9 / totalNs : 0.0);
+    
+    // еAIÿһѡ
+    sampleCount = 0;
+    calls = totalNs = 0;
+    for (int p = 0; p < benchCorpusSize; p++) {
+        int count = loadPosition(&bs, benchCorpus[p]);
+        ChessType player = (count % 2) ? CT_WHITE : CT_BLACK;
+        for (int r = 0; r < reps; r++) {
+            long long t0 = nowNs();
+            benchSink += Bench::mediumAIMove(&bs, player).row;
+            long long ns = nowNs() - t0;
+            samples[sampleCount++] = ns;
+            calls++;
+            totalNs += ns;
+        }
+    }
+    reportLatency("mediumAIMove", samples, sampleCount, calls, totalNs);
+    
+    // AI붨ÿһΣûձ֤ɸ
+    searchMaxDepth = depth;
+    searchTimeMs = 0;
+    sampleCount = 0;
+    calls = totalNs = 0;
+    for (int p = 0; p < benchCorpusSize; p++) {
+        int count = loadPosition(&bs, benchCorpus[p]);
+        ChessType player = (count % 2) ? CT_WHITE : CT_BLACK;
+        ttClear(&tt);
+        long long t0 = nowNs();
+        benchSink += Bench::hardAIMove(&bs, player).row;
+        long long ns = nowNs() - t0;
+        samples[sampleCount++] = ns;
+        calls++;
+        totalNs += ns;
+    }
+    reportLatency("hardAIMove", samples, sampleCount, calls, totalNs);
+    
+    long long totalNodes = 0;
+    sampleCount = 0;
+    calls = totalNs = 0;
+    for (int p = 0; p < benchCorpusSize; p++) {
+        int count = loadPosition(&bs, benchCorpus[p]);
+        ChessType player = (count % 2) ? CT_WHITE : CT_BLACK;
+        SearchLimits limits = {0, depth, 1, NULL, NULL, 0};
+        ttClear(&tt);
+        long long t0 = nowNs();
+        SearchResult result = Bench::searchPosition(&bs, player, &limits);
+        long long ns = nowNs() - t0;
+        printf("{\"bench\":\"search\",\"position\":%d,\"depth\":%d,\"move\":[%d,%d],"
+               "\"score\":%d,\"nodes\":%lld,\"time_ns\":%lld,\"nps\":%.0f}\n",
+               p, result.depth, result.bestMove.row, result.bestMove.col, result.score,
+               result.nodes, ns, ns > 0 ? result.nodes * 1e9 / ns : 0.0);
+        samples[sampleCount++] = ns;
+        totalNodes += result.nodes;
+        calls++;
+        totalNs += ns;
+    }
+    reportLatency("search", samples, sampleCount, calls, totalNs);
+    printf("{\"bench\":\"search_total\",\"depth\":%d,\"nodes\":%lld,\"nps\":%.0f}\n",
+           depth, totalNodes, totalNs > 0 ? totalNodes * 1e9 / totalNs : 0.0);
+    
+    // 1248̷ֱ߳ÿ棬speedupΪ̵߳ͬһȵʱ֮
+    long long* singleNs = new long long[benchCorpusSize];
+    for (int threads = 1; threads <= 8 && threads <= MAX_SEARCH_THREADS; threads *= 2) {
+        totalNodes = 0;
+        totalNs = 0;
+        long long singleTotalNs = 0;
+        for (int p = 0; p < benchCorpusSize; p++) {
+            int count = loadPosition(&bs, benchCorpus[p]);
+            ChessType player = (count % 2) ? CT_WHITE : CT_BLACK;
+            SearchLimits limits = {0, depth, threads, NULL, NULL, 0};
+            ttClear(&tt);
+            long long t0 = nowNs();
+            SearchResult result = Bench::searchPosition(&bs, player, &limits);
+            long long ns = nowNs() - t0;
+            if (threads == 1) singleNs[p] = ns;
+            printf("{\"bench\":\"search_threads\",\"threads\":%d,\"position\":%d,\"depth\":%d,"
+                   "\"nodes\":%lld,\"time_ns\":%lld,\"speedup\":%.2f}\n",
+                   threads, p, result.depth, result.nodes, ns, ns > 0 ? (double)singleNs[p] / ns : 0.0);
+            totalNodes += result.nodes;
+            totalNs += ns;
+            singleTotalNs += singleNs[p];
+        }
+        printf("{\"bench\":\"search_threads_total\",\"threads\":%d,\"depth\":%d,\"nodes\":%lld,"
+               "\"time_ns\":%lld,\"speedup\":%.2f}\n",
+               threads, depth, totalNodes, totalNs, totalNs > 0 ? (double)singleTotalNs / totalNs : 0.0);
+    }
+    delete[] singleNs;
+    
+    delete[] samples;
+    return 0;
+}
+
+// Զģ̶߳ɾֲսȥ
+template <int N>
+int runMatch(int argc, char* argv[]) {
+    if (argc < 2 || findEngine<N>(argv[0]) == NULL || findEngine<N>(argv[1]) == NULL) {
+        return -1;
+    }
+    const Engine<N>* a = findEngine<N>(argv[0]);
+    const Engine<N>* b = findEngine<N>(argv[1]);
+    int games = (argc > 2) ? atoi(argv[2]) : 1000;
+    int threads = (argc > 3) ? atoi(argv[3]) : defaultSearchThreads();
+    if (threads < 1) threads = 1;
+    if (argc > 4) searchTimeMs = atoi(argv[4]);
+    else searchTimeMs = 50;
+    
+    srand((unsigned)time(NULL));
+    ttResize(&tt, TT_DEFAULT_MB);
+    searchThreads = 1;             // зڶԾ֮䣬ÿֻһ߳
+    
+    std::atomic<int> nextGame(0);
+    MatchStats* stats = new MatchStats[threads];
+    std::thread* workers = new std::thread[threads];
+    long long start = nowUs();
+    for (int i = 0; i < threads; i++) {
+        workers[i] = std::thread(matchWorker<N>, a, b, games, &nextGame, &stats[i]);
+    }
+    MatchStats total;
+    memset(&total, 0, sizeof(total));
+    for (int i = 0; i < threads; i++) {
+        workers[i].join();
+        for (int e = 0; e < 2; e++) {
+            total.wins[e] += stats[i].wins[e];
+            total.moves[e] += stats[i].moves[e];
+            total.thinkUs[e] += stats[i].thinkUs[e];
+            summaryMerge(&total.profile[e], &stats[i].profile[e]);
+        }
+        total.draws += stats[i].draws;
+    }
+    double seconds = (nowUs() - start) / 1e6;
+    
+    printf("%s vs %s: %d games, %dx%d, %d threads, %.2f s\n", a->name, b->name, games, N, N, threads, seconds);
+    const Engine<N>* named[2] = {a, b};
+    for (int e = 0; e < 2; e++) {
+        printf("  %-8s wins %6d (%5.1f%%)  avg move %.3f ms\n", named[e]->name, total.wins[e],
+               100.0 * total.wins[e] / games,
+               total.moves[e] ? total.thinkUs[e] / 1000.0 / total.moves[e] : 0.0);
+    }
+    printf("  %-8s      %6d (%5.1f%%)\n", "draws", total.draws, 100.0 * total.draws / games);
+    printf("  throughput %.1f games/s\n", games / seconds);
+    if (profileLog != NULL) {
+        char fields[4096];
+        for (int e = 0; e < 2; e++) {
+            summaryFormat(&total.profile[e], fields, sizeof(fields));
+            printf("{\"profile\":\"summary\",\"engine\":\"%s\",\"size\":%d,%s}\n", named[e]->name, N, fields);
+        }
+    }
+    
+    delete[] workers;
+    delete[] stats;
+    return 0;
+}
+
+// ===== Ծͳ =====
+// ӿ˫пλȫӣֵַ̲߳УͳȺֵʤʺƽ
+// ͬʱģںÿÿľ
+
+// һ̵߳Ծͳ
+typedef struct {
+    long long results[3];      // ʤChessTypeCT_EMPTYΪ
+    long long stones;          // 
+    long long ns;              // ߳ʱ룩
+} RolloutStats;
+
+template <int N>
+void rolloutWorker(long long games, unsigned long long seed, int index, RolloutStats* stats) {
+    typedef Connect6<N> C6;
+    typename C6::BitBoard empty;
+    typename C6::PlayoutBoard start, pb;
+    Rng rng;
+    C6::bitboardReset(&empty);
+    C6::playoutInit(&start, &empty);
+    rngSeed(&rng, seed, (unsigned long long)index);
+    memset(stats, 0, sizeof(RolloutStats));
+    
+    long long t0 = nowNs();
+    for (long long g = 0; g < games; g++) {
+        int length;
+        pb = start;
+        stats->results[C6::randomPlayout(&pb, ruleMode, 0, &rng, &length)]++;
+        stats->stones += length;
+    }
+    stats->ns = nowNs() - t0;
+}
+
+template <int N>
+int runRollout(int argc, char* argv[]) {
+    long long games = (argc > 0) ? atoll(argv[0]) : 1000000;
+    int threads = (argc > 1) ? atoi(argv[1]) : defaultSearchThreads();
+    if (games < 1) games = 1;
+    if (threads < 1) threads = 1;
+    
+    RolloutStats* stats = new RolloutStats[threads];
+    std::thread* workers = new std::thread[threads];
+    unsigned long long seed = (unsigned long long)nowNs();
+    long long start = nowUs();
+    for (int i = 0; i < threads; i++) {
+        long long share = games / threads + (i < games % threads ? 1 : 0);
+        workers[i] = std::thread(rolloutWorker<N>, share, seed, i, &stats[i]);
+    }
+    RolloutStats total;
+    memset(&total, 0, sizeof(total));
+    for (int i = 0; i < threads; i++) {
+        workers[i].join();
+        for (int k = 0; k < 3; k++) total.results[k] += stats[i].results[k];
+        total.stones += stats[i].stones;
+        total.ns += stats[i].ns;
+    }
+    double seconds = (nowUs() - start) / 1e6;
+    
+    printf("random games: %lld games, %dx%d, %s, %d threads, %.2f s\n", games, N, N,
+           ruleMode == RULE_CONNECT6 ? "connect6" : "one stone", threads, seconds);
+    printf("  %-8s wins %9lld (%5.1f%%)\n", "black", total.results[CT_BLACK], 100.0 * total.results[CT_BLACK] / games);
+    printf("  %-8s wins %9lld (%5.1f%%)\n", "white", total.results[CT_WHITE], 100.0 * total.results[CT_WHITE] / games);
+    printf("  %-8s      %9lld (%5.1f%%)\n", "draws", total.results[CT_EMPTY], 100.0 * total.results[CT_EMPTY] / games);
+    printf("  avg stones %.1f\n", (double)total.stones / games);
+    printf("  throughput %.0f games/s, %.0f games/s per thread\n", games / seconds,
+           total.ns > 0 ? games * 1e9 / total.ns : 0.0);
+    
+    delete[] workers;
+    delete[] stats;
+    return 0;
+}
+
+// =====  =====
+// ӱ׼жȡ棬ÿǰ˳µУ"7,7 8,6 9,4"Сд0ʼ
+// ÿһ","ʽAIŷ˫ӹֵʱ", ,"
+// Ƿʱ"error"жӦ
+template <int N>
+int runAnalyze(int argc, char* argv[]) {
+    typedef Connect6<N> C6;
+    const Engine<N>* engine = (argc > 0) ? findEngine<N>(argv[0]) : NULL;
+    if (engine == NULL) {
+        return -1;
+    }
+    searchTimeMs = (argc > 1) ? atoi(argv[1]) : SEARCH_TIME_MS;
+    
+    rngSeed(threadRng(), 1, 0);    // AIѡɸ
+    ttResize(&tt, TT_DEFAULT_MB);
+    searchThreads = 1;             // ߳ɸ
+    
+    char line[4096];
+    int lineNo = 0;
+    while (fgets(line, sizeof(line), stdin) != NULL) {
+        lineNo++;
+        typename C6::BoardState bs;
+        C6::boardReset(&bs);
+        
+        int count = 0;
+        bool valid = true;
+        bool finished = false;
+        const char* p = line;
+        int row, col, used;
+        while (sscanf(p, " %d,%d%n", &row, &col, &used) == 2) {
+            p += used;
+            ChessType player = stoneOwner(ruleMode, count);
+            if (finished || count >= C6::MAX_MOVES ||
+                row < 0 || row >= N || col < 0 || col >= N ||
+                C6::bitboardGet(&bs.bits, row, col) != CT_EMPTY) {
+                valid = false;
+                break;
+            }
+            finished = C6::boardCheckWin(&bs, row, col, player, NULL);
+            C6::boardPlace(&bs, row, col, player);
+            count++;
+        }
+        while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') p++;
+        if (!valid || finished || count >= C6::MAX_MOVES || *p != '\0') {
+            fprintf(stderr, "line %d: illegal or finished position\n", lineNo);
+            printf("error\n");
+            continue;
+        }
+        
+        ChessType player = stoneOwner(ruleMode, count);
+        MoveProfile profile;
+        profileBegin(&profile);
+        if (stonesToPlay(ruleMode, count) == 2 && count + 2 <= C6::MAX_MOVES) {
+            StonePair pair = engine->pair(&bs, player);
+            profileEnd(&profile);
+            if (pair.second.row >= 0) {
+                printf("%d,%d %d,%d\n", pair.first.row, pair.first.col, pair.second.row, pair.second.col);
+            } else {
+                printf("%d,%d\n", pair.first.row, pair.first.col);
+            }
+        } else {
+            Position m = engine->move(&bs, player);
+            profileEnd(&profile);
+            printf("%d,%d\n", m.row, m.col);
+        }
+        fflush(stdout);
+        if (profileLog != NULL) {
+            writeProfile(engine->name, N, count, &profile);
+        }
+    }
+    return 0;
+}
+
+// ===== GomocupPiskvorkЭ =====
+// ͨ׼棺STARTBEGINTURNBOARDTAKEBACKRESTARTINFOABOUTEND
+// Ϊ"x,y"","0ʼʤ԰顢ÿһж
+#define PROTOCOL_RESERVE_MB 16     // max_memoryû⣨߳ջ渱Ĳ
+#define PROTOCOL_MARGIN_MS 30      // ÿʱͽ̵ȵ
+
+// ЭģʽµĶԾ֣ÿ̴Сһ
+template <int N>
+typename Connect6<N>::GameState protocolGame;
+
+// ЭỰ״̬START֮ǰsizeΪ0
+typedef struct {
+    int size;                  // ̴С
+    const char* engineName;    // ʹһAI
+    int timeoutTurnMs;         // ÿʱޣ0ʾ
+    long long timeLeftMs;      // ʣʱ䣬-1ʾûʱ
+    long long maxMemory;       // ڴޣֽڣ0ʾ
+    size_t ttMegabytes;        // ǰûĴСMB0ʾûз
+} ProtocolState;
+
+// max_memory·ûͷžɱ֤¾űͬʱռڴ档
+// ؿAIûûֻ1MBڵأڵһʱ·䣩
+void protocolApplyMemory(ProtocolState* st) {
+    size_t mb = TT_DEFAULT_MB;
+    long long poolNodes = MCTS_POOL_NODES;
+    if (st->maxMemory > 0) {
+        long long available = st->maxMemory / (1024 * 1024) - PROTOCOL_RESERVE_MB;
+        if (available < 1) available = 1;
+        if (strcmp(st->engineName, "mcts") == 0) {
+            mb = 1;
+            poolNodes = (available - 1) * 1024 * 1024 / (long long)sizeof(Connect6<15>::MctsNode);
+            if (poolNodes < MCTS_MIN_POOL_NODES) poolNodes = MCTS_MIN_POOL_NODES;
+            if (poolNodes > MCTS_POOL_NODES) poolNodes = MCTS_POOL_NODES;
+        } else {
+            mb = (size_t)available;
+            if (mb > TT_DEFAULT_MB * 16) mb = TT_DEFAULT_MB * 16;
+        }
+    }
+    mctsPoolNodes = (int)poolNodes;
+    if (mb != st->ttMegabytes) {
+        ttRelease(&tt);
+        ttResize(&tt, mb);
+        st->ttMegabytes = mb;
+    }
+}
+
+// timeout_turntime_leftһʱ䣬1
+template <int N>
+int protocolMoveTime(const ProtocolState* st) {
+    int limit = (st->timeoutTurnMs > 0) ? st->timeoutTurnMs : MIN_MOVE_TIME_MS;
+    if (st->timeLeftMs >= 0) {
+        TimeControl tc = {TC_TOTAL_CLOCK, 0, 0, 0};
+        int share = Connect6<N>::allocateMoveTime(&tc, st->timeLeftMs, protocolGame<N>.rule, protocolGame<N>.moveCount);
+        if (share > st->timeLeftMs / 2) share = (int)(st->timeLeftMs / 2);
+        if (share < limit) limit = share;
+    }
+    limit -= PROTOCOL_MARGIN_MS + limit / 20;
+    return (limit < 1) ? 1 : limit;
+}
+
+// ֵ棺ʱ˼Ӳ"x,y"
+template <int N>
+void protocolThink(ProtocolState* st) {
+    typedef Connect6<N> C6;
+    typename C6::GameState* game = &protocolGame<N>;
+    if (game->status != GS_PLAYING) {
+        printf("ERROR game is over\n");
+        return;
+    }
+    if (st->ttMegabytes == 0) {
+        protocolApplyMemory(st);
+    }
+    searchTimeMs = protocolMoveTime<N>(st);
+    
+    ChessType player = stoneOwner(game->rule, game->moveCount);
+    Position m = findEngine<N>(st->engineName)->move(&game->board, player);
+    if (!C6::playMove(game, m.row, m.col, player)) {
+        printf("ERROR no move\n");
+        return;
+    }
+    printf("%d,%d\n", m.col, m.row);
+}
+
+// һҪ̵תɴдfalseʾʶ
+template <int N>
+bool protocolCommand(ProtocolState* st, const char* command, const char* args) {
+    typedef Connect6<N> C6;
+    typename C6::GameState* game = &protocolGame<N>;
+    int x, y, field;
+    
+    if (strcmp(command, "BEGIN") == 0) {
+        protocolThink<N>(st);
+    } else if (strcmp(command, "TURN") == 0) {
+        if (sscanf(args, "%d,%d", &x, &y) != 2 ||
+            !C6::playMove(game, y, x, stoneOwner(game->rule, game->moveCount))) {
+            printf("ERROR illegal move\n");
+        } else {
+            protocolThink<N>(st);
+        }
+    } else if (strcmp(command, "BOARD") == 0) {
+        // ж"x,y,field"ֱDONEfieldΪ1Լӣ2Ƕֵӣ
+        // Щֵ֮棬ݴƳ˫ɫ
+        int stones[C6::MAX_MOVES][3];
+        int count = 0;
+        bool valid = true;
+        char line[256];
+        while (fgets(line, sizeof(line), stdin) != NULL && strncmp(line, "DONE", 4) != 0) {
+            if (sscanf(line, "%d,%d,%d", &x, &y, &field) != 3 || count >= C6::MAX_MOVES ||
+                (field != 1 && field != 2)) {
+                valid = false;
+                continue;
+            }
+            stones[count][0] = y;
+            stones[count][1] = x;
+            stones[count][2] = field;
+            count++;
+        }
+        
+        C6::resetGame(game, RULE_ONE_STONE);
+        ChessType own = stoneOwner(game->rule, count);
+        ChessType opponent = (own == CT_BLACK) ? CT_WHITE : CT_BLACK;
+        for (int i = 0; i < count && valid; i++) {
+            valid = C6::playMove(game, stones[i][0], stones[i][1], stones[i][2] == 1 ? own : opponent);
+        }
+        if (valid) {
+            protocolThink<N>(st);
+        } else {
+            printf("ERROR bad board\n");
+        }
+    } else if (strcmp(command, "TAKEBACK") == 0) {
+        // ͨصһӣֱӻ壻ȥһӺԭɫ°һ
+        int index = -1;
+        if (sscanf(args, "%d,%d", &x, &y) == 2) {
+            for (int i = 0; i < game->moveCount; i++) {
+                if (game->moveHistory[i][0] == y && game->moveHistory[i][1] == x) index = i;
+            }
+        }
+        if (index < 0) {
+            printf("ERROR no stone at %s\n", args);
+        } else if (index == game->moveCount - 1) {
+            C6::undoMove(game);
+            printf("OK\n");
+        } else {
+            int stones[C6::MAX_MOVES][3];
+            int count = 0;
+            for (int i = 0; i < game->moveCount; i++) {
+                if (i == index) continue;
+                stones[count][0] = game->moveHistory[i][0];
+                stones[count][1] = game->moveHistory[i][1];
+                stones[count][2] = C6::bitboardGet(&game->board.bits, stones[count][0], stones[count][1]);
+                count++;
+            }
+            C6::resetGame(game, RULE_ONE_STONE);
+            for (int i = 0; i < count; i++) {
+                C6::playMove(game, stones[i][0], stones[i][1], (ChessType)stones[i][2]);
+            }
+            printf("OK\n");
+        }
+    } else if (strcmp(command, "RESTART") == 0) {
+        C6::resetGame(game, RULE_ONE_STONE);
+        printf("OK\n");
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// ЭģʽΪʹõAIĬhard߳
+int runProtocol(int argc, char* argv[]) {
+    ProtocolState st;
+    st.size = 0;
+    st.engineName = (argc > 0) ? argv[0] : "hard";
+    st.timeoutTurnMs = SEARCH_TIME_MS;
+    st.timeLeftMs = -1;
+    st.maxMemory = 0;
+    st.ttMegabytes = 0;
+    if (findEngine<15>(st.engineName) == NULL) {
+        return -1;
+    }
+    searchThreads = (argc > 1) ? atoi(argv[1]) : defaultSearchThreads();
+    if (searchThreads < 1) searchThreads = 1;
+    if (searchThreads > MAX_SEARCH_THREADS) searchThreads = MAX_SEARCH_THREADS;
+    srand((unsigned)time(NULL));
+    setvbuf(stdout, NULL, _IOLBF, 0);    // жȡÿظͳ
+    
+    char line[256];
+    while (fgets(line, sizeof(line), stdin) != NULL) {
+        // תдͲȥ˵Ŀհףʱԭ
+        char command[32];
+        int length = 0;
+        line[strcspn(line, "\r\n")] = '\0';
+        const char* p = line;
+        while (*p == ' ' || *p == '\t') p++;
+        while (*p != '\0' && *p != ' ' && *p != '\t' && length < 31) {
+            command[length++] = (char)toupper((unsigned char)*p++);
+        }
+        command[length] = '\0';
+        while (*p == ' ' || *p == '\t') p++;
+        const char* args = p;
+        if (length == 0) {
+            continue;
+        }
+        
+        if (strcmp(command, "END") == 0) {
+            break;
+        } else if (strcmp(command, "ABOUT") == 0) {
+            printf("name=\"connect6\", version=\"1.0\", country=\"China\"\n");
+        } else if (strcmp(command, "START") == 0) {
+            int size = atoi(args);
+            if (size != 15 && size != 19) {
+                printf("ERROR unsupported size %d, only 15 and 19\n", size);
+                continue;
+            }
+            // ̴СʱԭߴĽڵزãȻϵͳ
+            if (st.size == 15 && size != 15) Connect6<15>::mctsReleasePools();
+            if (st.size == 19 && size != 19) Connect6<19>::mctsReleasePools();
+            st.size = size;
+            protocolApplyMemory(&st);
+            if (size == 19) Connect6<19>::resetGame(&protocolGame<19>, RULE_ONE_STONE);
+            else Connect6<15>::resetGame(&protocolGame<15>, RULE_ONE_STONE);
+            printf("OK\n");
+        } else if (strcmp(command, "INFO") == 0) {
+            char key[32];
+            long long value;
+            if (sscanf(args, "%31s %lld", key, &value) != 2) {
+                continue;
+            }
+            if (strcmp(key, "timeout_turn") == 0) {
+                st.timeoutTurnMs = (int)value;
+            } else if (strcmp(key, "time_left") == 0) {
+                st.timeLeftMs = value;
+            } else if (strcmp(key, "max_memory") == 0) {
+                st.maxMemory = value;
+                if (st.ttMegabytes != 0) protocolApplyMemory(&st);
+            }
+            // INFOtimeout_matchgame_typeruleȣӰ챾
+        } else if (strcmp(command, "RECTSTART") == 0) {
+            printf("ERROR rectangular boards are not supported\n");
+        } else if (st.size == 0) {
+            printf("ERROR send START first\n");
+        } else if (st.size == 19 ? !protocolCommand<19>(&st, command, args)
+                                 : !protocolCommand<15>(&st, command, args)) {
+            printf("UNKNOWN %s\n", command);
+        }
+    }
+    ttRelease(&tt);
+    return 0;
+}
+
+// ===== Ựز =====
+// һģͻͬʱԾ֣ͻִڣ˼ԼthinkMsӣ
+// ִףлỰAIɹĹȡ̳߳ؼ㡣
+// Ựÿ߳4ʼɱӣֱAIp99ʱĿ꣬ÿܳصĻỰ
+#define LOAD_CLIENT_THREADS 2      // ģͻ˵߳
+#define LOAD_MAX_SESSIONS 32768    // Ự
+
+// ͻ̣߳ѯԼĻỰӣԾֽͻһµ
+template <int N>
+void loadClient(int* ids, int count, GameMode mode, int thinkMs, const std::atomic<bool>* stop) {
+    typedef GameServer<N> Server;
+    long long* due = new long long[count];    // ÿỰһӵʱ̣0ʾû
+    for (int i = 0; i < count; i++) due[i] = 0;
+    
+    while (!stop->load()) {
+        bool acted = false;
+        long long now = nowNs();
+        for (int i = 0; i < count; i++) {
+            typename Server::Session* s = &Server::sessions[ids[i]];
+            int state = s->state.load();
+            if (state == SS_OVER) {
+                Server::sessionClose(ids[i]);
+                ids[i] = Server::sessionOpen(mode, ruleMode);
+                due[i] = 0;
+                acted = true;
+                continue;
+            }
+            if (state != SS_CLIENT) {
+                continue;
+            }
+            if (due[i] == 0) {
+                // ˼ʱthinkMsһ뵽һ֮пͻͬʱ
+                long long think = thinkMs > 0 ? thinkMs / 2 + rand() % (thinkMs + 1) : 0;
+                due[i] = now + think * 1000000;
+            }
+            if (now < due[i]) {
+                continue;
+            }
+            
+            Position m;
+            {
+                std::lock_guard<std::mutex> guard(s->lock);
+                m = Connect6<N>::easyAIMove(&s->game.board, s->game.currentPlayer);
+            }
+            if (m.row < 0) {
+                m.row = N / 2;
+                m.col = N / 2;
+            }
+            due[i] = 0;
+            Server::sessionPlay(ids[i], m.row, m.col);
+            acted = true;
+        }
+        if (!acted) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    delete[] due;
+}
+
+// زԣload <> [߳] [ͻ˼] [p99Ŀ] [ÿ] [AIÿ]
+template <int N>
+int runLoad(int argc, char* argv[]) {
+    typedef GameServer<N> Server;
+    const Engine<N>* engine = (argc > 0) ? findEngine<N>(argv[0]) : NULL;
+    if (engine == NULL) {
+        return -1;
+    }
+    GameMode mode = (GameMode)(engine - engines<N> + GM_PVE_EASY);
+    int workers = (argc > 1) ? atoi(argv[1]) : defaultSearchThreads();
+    int thinkMs = (argc > 2) ? atoi(argv[2]) : 500;
+    int targetMs = (argc > 3) ? atoi(argv[3]) : 100;
+    int seconds = (argc > 4) ? atoi(argv[4]) : 3;
+    int hardMs = (argc > 5) ? atoi(argv[5]) : 20;
+    if (workers < 1) workers = 1;
+    if (seconds < 1) seconds = 1;
+    
+    srand((unsigned)time(NULL));
+    ttResize(&tt, TT_DEFAULT_MB);
+    ThreadPool pool;
+    poolStart(&pool, workers, LOAD_MAX_SESSIONS);
+    // ÿAI󲻻ᳬÿỰÿһ
+    long long samples = (long long)LOAD_MAX_SESSIONS * seconds * 20;
+    if (!Server::serverStart(LOAD_MAX_SESSIONS, &pool, hardMs, samples)) {
+        fprintf(stderr, "out of memory\n");
+        poolStop(&pool);
+        return 1;
+    }
+    
+    int* ids = new int[LOAD_MAX_SESSIONS];
+    int bestSessions = 0;
+    for (int sessions = workers * 4; sessions <= LOAD_MAX_SESSIONS; sessions *= 2) {
+        for (int i = 0; i < sessions; i++) {
+            ids[i] = Server::sessionOpen(mode, ruleMode);
+        }
+        
+        // ͻһöԾֽ̣ٿʼͳ
+        std::atomic<bool> stop(false);
+        std::thread clients[LOAD_CLIENT_THREADS];
+        int share = (sessions + LOAD_CLIENT_THREADS - 1) / LOAD_CLIENT_THREADS;
+        for (int c = 0; c < LOAD_CLIENT_THREADS; c++) {
+            int first = c * share;
+            int count = (first + share <= sessions) ? share : sessions - first;
+            clients[c] = std::thread(loadClient<N>, ids + first, count, mode, thinkMs, &stop);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(thinkMs * 2 + 200));
+        Server::resetStats();
+        long long executed = pool.executed.load();
+        long long stolen = pool.stolen.load();
+        clock_t cpuStart = clock();
+        long long start = nowNs();
+        std::this_thread::sleep_for(std::chrono::seconds(seconds));
+        long long elapsedNs = nowNs() - start;
+        double cpu = (double)(clock() - cpuStart) / CLOCKS_PER_SEC;
+        long long requests = Server::latencyCount.load();
+        long long games = Server::gamesFinished.load();
+        executed = pool.executed.load() - executed;
+        stolen = pool.stolen.load() - stolen;
+        stop.store(true);
+        for (int c = 0; c < LOAD_CLIENT_THREADS; c++) {
+            clients[c].join();
+        }
+        for (int i = 0; i < sessions; i++) {
+            Server::sessionClose(ids[i]);
+        }
+        
+        if (requests > Server::latencyCapacity) requests = Server::latencyCapacity;
+        if (requests == 0) {
+            break;
+        }
+        qsort(Server::latencyNs, requests, sizeof(long long), compareLongLong);
+        long long p50 = Server::latencyNs[(requests - 1) / 2];
+        long long p99 = Server::latencyNs[(requests - 1) * 99 / 100];
+        long long worst = Server::latencyNs[requests - 1];
+        printf("{\"load\":\"%s\",\"size\":%d,\"sessions\":%d,\"workers\":%d,\"ai_moves_per_s\":%.1f,"
+               "\"games_per_s\":%.1f,\"p50_us\":%lld,\"p99_us\":%lld,\"max_us\":%lld,"
+               "\"cpu_cores\":%.2f,\"stolen_pct\":%.1f}\n",
+               engine->name, N, sessions, workers, requests * 1e9 / elapsedNs, games * 1e9 / elapsedNs,
+               p50 / 1000, p99 / 1000, worst / 1000, cpu * 1e9 / elapsedNs,
+               executed ? 100.0 * stolen / executed : 0.0);
+        fflush(stdout);
+        if (p99 > targetMs * 1000000LL) {
+            break;
+        }
+        bestSessions = sessions;
+    }
+    // ̱߳CPU˶ʱʵʵĺ
+    int cores = (workers < defaultSearchThreads()) ? workers : defaultSearchThreads();
+    printf("{\"load\":\"%s\",\"size\":%d,\"think_ms\":%d,\"p99_target_ms\":%d,\"max_sessions\":%d,"
+           "\"cores\":%d,\"sessions_per_core\":%.1f}\n",
+           engine->name, N, thinkMs, targetMs, bestSessions, cores, (double)bestSessions / cores);
+    
+    delete[] ids;
+    poolStop(&pool);
+    Server::serverStop();
+    return 0;
+}
+
+// ===== Ծ־ =====
+// ӳ־ֶȡܣdumpʱÿһŷУʽanalyzeͬ
+int runReplay(int argc, char* argv[]) {
+    if (argc < 1) {
+        return -1;
+    }
+    bool dump = (argc > 1 && strcmp(argv[1], "dump") == 0);
+    
+    GameLogReader reader;
+    if (!gameLogMap(&reader, argv[0])) {
+        fprintf(stderr, "cannot open %s\n", argv[0]);
+        return 1;
+    }
+    
+    long long games = 0, stones = 0, results[4] = {0, 0, 0, 0};
+    long long searched = 0, depthSum = 0, thinkMs = 0;
+    long long bySize[MAX_BOARD_SIZE + 1] = {0};
+    long long start = nowUs();
+    GameRecord record;
+    while (gameLogNext(&reader, &record)) {
+        games++;
+        stones += record.moveCount;
+        bySize[record.boardSize]++;
+        if (record.result <= GS_DRAW) results[record.result]++;
+        for (int i = 0; i < record.moveCount; i++) {
+            if (dump) {
+                Position m = gameRecordMove(&record, i);
+                printf(i ? " %d,%d" : "%d,%d", m.row, m.col);
+            }
+            if (record.stats != NULL) {
+                MoveStat stat = gameRecordStat(&record, i);
+                thinkMs += stat.thinkMs;
+                if (stat.depth > 0) {
+                    searched++;
+                    depthSum += stat.depth;
+                }
+            }
+        }
+        if (dump) printf("\n");
+    }
+    double seconds = (nowUs() - start) / 1e6;
+    size_t parsed = reader.offset;
+    size_t bytes = reader.size;
+    bool complete = (parsed == bytes);
+    gameLogUnmap(&reader);
+    
+    if (dump) {
+        return complete ? 0 : 1;
+    }
+    printf("%s: %lld games, %lld stones, %.1f bytes/stone\n", argv[0], games, stones,
+           stones ? (double)bytes / stones : 0.0);
+    printf("  15x15 %lld  19x19 %lld\n", bySize[15], bySize[19]);
+    printf("  black %lld  white %lld  draw %lld  unfinished %lld\n",
+           results[GS_BLACK_WIN], results[GS_WHITE_WIN], results[GS_DRAW], results[GS_PLAYING]);
+    printf("  avg stones %.1f  think %.1f s  searched stones %lld (avg depth %.1f)\n",
+           games ? (double)stones / games : 0.0, thinkMs / 1000.0, searched,
+           searched ? (double)depthSum / searched : 0.0);
+    printf("  read %.3f s, %.0f games/s\n", seconds, seconds > 0 ? games / seconds : 0.0);
+    if (!complete) {
+        printf("  trailing %zu bytes are not a complete record\n", bytes - parsed);
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    // ǰĿѡ--sizeѡ̴С--connect6ʹ˫ӹ--log¼Զģ--profileͳƣ
+    // --random-playoutsؿAIȫģ
+    int size = 15;
+    const char* logPath = NULL;
+    const char* profilePath = NULL;
+    int first = 1;
+    while (first < argc && strncmp(argv[first], "--", 2) == 0) {
+        if (strcmp(argv[first], "--size") == 0 && first + 1 < argc) {
+            size = atoi(argv[first + 1]);
+            first += 2;
+        } else if (strcmp(argv[first], "--connect6") == 0) {
+            ruleMode = RULE_CONNECT6;
+            first++;
+        } else if (strcmp(argv[first], "--log") == 0 && first + 1 < argc) {
+            logPath = argv[first + 1];
+            first += 2;
+        } else if (strcmp(argv[first], "--random-playouts") == 0) {
+            mctsBiased = false;
+            first++;
+        } else if (strcmp(argv[first], "--profile") == 0 && first + 1 < argc) {
+            profilePath = argv[first + 1];
+            first += 2;
+        } else {
+            size = 0;
+            break;
+        }
+    }
+    const char* command = (argc > first) ? argv[first] : "";
+    int rest = argc - first - 1;
+    char** restArgv = argv + first + 1;
+    int status = -1;
+    if (profilePath != NULL) {
+        // "-"ʾ׼ŷһ
+        profileLog = (strcmp(profilePath, "-") == 0) ? stderr : fopen(profilePath, "a");
+        if (profileLog == NULL) {
+            fprintf(stderr, "cannot open %s\n", profilePath);
+            return 1;
+        }
+    }
+    if (size != 15 && size != 19) {
+        status = -1;
+    } else if (strcmp(command, "match") == 0) {
+        GameLogWriter log;
+        if (logPath != NULL) {
+            if (!gameLogOpen(&log, logPath)) {
+                fprintf(stderr, "cannot open %s\n", logPath);
+                return 1;
+            }
+            matchLog = &log;
+        }
+        status = (size == 19) ? runMatch<19>(rest, restArgv) : runMatch<15>(rest, restArgv);
+        if (matchLog != NULL) {
+            if (status == 0) printf("  logged %lld games to %s\n", log.games, logPath);
+            gameLogClose(&log);
+            matchLog = NULL;
+        }
+    } else if (strcmp(command, "bench") == 0 && size == 15 && ruleMode == RULE_ONE_STONE) {
+        status = runBenchmark(rest, restArgv);
+    } else if (strcmp(command, "analyze") == 0) {
+        status = (size == 19) ? runAnalyze<19>(rest, restArgv) : runAnalyze<15>(rest, restArgv);
+    } else if (strcmp(command, "replay") == 0) {
+        status = runReplay(rest, restArgv);
+    } else if (strcmp(command, "protocol") == 0 && ruleMode == RULE_ONE_STONE) {
+        status = runProtocol(rest, restArgv);
+    } else if (strcmp(command, "load") == 0) {
+        status = (size == 19) ? runLoad<19>(rest, restArgv) : runLoad<15>(rest, restArgv);
+    } else if (strcmp(command, "rollout") == 0) {
+        status = (size == 19) ? runRollout<19>(rest, restArgv) : runRollout<15>(rest, restArgv);
+    }
+    if (profileLog != NULL && profileLog != stderr) {
+        fclose(profileLog);
+    }
+    profileLog = NULL;
+    if (status < 0) {
+        printf("usage: %s [--size 15|19] [--connect6] [--log file] [--profile file] [--random-playouts] match <engineA> <engineB> [games] [threads] [hardMs]\n", argv[0]);
+        printf("       %s bench [depth] [reps]\n", argv[0]);
+        printf("       %s [--size 15|19] [--connect6] [--profile file] [--random-playouts] analyze <engine> [hardMs] < positions.txt\n", argv[0]);
+        printf("       %s replay <logfile> [dump]\n", argv[0]);
+        printf("       %s protocol [engine] [threads]\n", argv[0]);
+        printf("       %s [--size 15|19] [--connect6] load <engine> [workers] [thinkMs] [p99TargetMs] [seconds] [hardMs]\n", argv[0]);
+        printf("       %s [--size 15|19] [--connect6] rollout [games] [threads]\n", argv[0]);
+        printf("engines:");
+        for (int i = 0; i < engineCount; i++) printf(" %s", engines<15>[i].name);
+        printf("\n");
+        return 1;
+    }
+    return status;
+}
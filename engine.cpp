@@ -0,0 +1,2806 @@
+// ʵ֣ӿڼengine.h
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+#include <chrono>
+#include <new>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+// ˰ĿѡָAVX2SSE2ñ
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define EVAL_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define EVAL_SSE2
+#endif
+// ͳƼʱôʱڼһֻҪʮڣԷÿڵ
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define STAT_RDTSC
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define STAT_RDTSC
+#endif
+#include "engine.h"
+
+// ȫֱ
+TranspositionTable tt;                     // û
+int searchThreads = 1;                     // AI߳
+int searchTimeMs = SEARCH_TIME_MS;         // AIÿʱ䣨룩<=0ʾʱ
+int searchMaxDepth = SEARCH_MAX_DEPTH;     // AI
+long long mctsPlayouts = MCTS_PLAYOUTS;    // ؿAIÿģ
+int mctsPoolNodes = MCTS_POOL_NODES;       // ؿĽڵ
+bool mctsBiased = true;                    // ؿAIʹʽģ
+RuleMode ruleMode = RULE_ONE_STONE;        // ӹ
+thread_local EngineStats engineStats;      // ̵߳ͳ
+
+// AI·ϵļͷֶμʱENGINE_STATSΪ0ʱȫչΪ
+#if ENGINE_STATS
+struct StatTimer {
+    EngineTimer timer;
+    unsigned long long start;
+    StatTimer(EngineTimer t) : timer(t), start(statTicks()) {}
+    ~StatTimer() { engineStats.ticks[timer] += statTicks() - start; }
+};
+#define STAT_ADD(counter, n) (engineStats.counters[counter] += (n))
+#define STAT_TIMER(timer) StatTimer statTimer(timer)
+#else
+#define STAT_ADD(counter, n) ((void)0)
+#define STAT_TIMER(timer) ((void)0)
+#endif
+
+// ÿ̴Сһݵ״̬Ծ״̬ÿһָԳһGameState
+template <int N> unsigned long long Connect6<N>::zobristKeys[2][N][N];                  // Zobrist
+template <int N> unsigned long long Connect6<N>::zobristSide;                           // ֵ׷ʱӵ
+template <int N> unsigned long long Connect6<N>::zobristPairs;                          // ˫ûӵ
+template <int N> typename Connect6<N>::Ponder Connect6<N>::ponder;                      // AIĺ̨˼ֻͼνʹã
+template <int N> typename Connect6<N>::MctsPool* Connect6<N>::mctsFreePools = NULL;     // еؿڵ
+template <int N> std::mutex Connect6<N>::mctsPoolLock;                                  // mctsFreePools
+
+// λ
+template <int N>
+void Connect6<N>::bitboardReset(BitBoard* bb) {
+    memset(bb, 0, sizeof(BitBoard));
+}
+
+// (row, col)һöӣͼͬʱ
+template <int N>
+void Connect6<N>::bitboardSet(BitBoard* bb, int row, int col, ChessType type) {
+    int c = type - CT_BLACK;
+    bb->rows[c][row] |= 1u << col;
+    bb->cols[c][col] |= 1u << row;
+    bb->diags[c][row - col + BOARD_SIZE - 1] |= 1u << col;
+    bb->antiDiags[c][row + col] |= 1u << col;
+}
+
+// Ƴ(row, col)ϵӣɫ
+template <int N>
+void Connect6<N>::bitboardClear(BitBoard* bb, int row, int col) {
+    for (int c = 0; c < 2; c++) {
+        bb->rows[c][row] &= ~(1u << col);
+        bb->cols[c][col] &= ~(1u << row);
+        bb->diags[c][row - col + BOARD_SIZE - 1] &= ~(1u << col);
+        bb->antiDiags[c][row + col] &= ~(1u << col);
+    }
+}
+
+// ѯ(row, col)ϵ
+template <int N>
+ChessType Connect6<N>::bitboardGet(const BitBoard* bb, int row, int col) {
+    if (bb->rows[0][row] & (1u << col)) return CT_BLACK;
+    if (bb->rows[1][row] & (1u << col)) return CT_WHITE;
+    return CT_EMPTY;
+}
+
+// rowеĿλλͼ
+template <int N>
+LineBits Connect6<N>::emptyBits(const BitBoard* bb, int row) {
+    return ~(bb->rows[0][row] | bb->rows[1][row]) & FULL_LINE;
+}
+
+// ȡλͼ͵λ±
+int lowestBit(LineBits bits) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, bits);
+    return (int)index;
+#else
+    return __builtin_ctz(bits);
+#endif
+}
+
+// λͼλĸ
+int bitCount(LineBits bits) {
+#ifdef _MSC_VER
+    return (int)__popcnt(bits);
+#else
+    return __builtin_popcount(bits);
+#endif
+}
+
+// ӵ㣺kλΪ1ʾkk+5λȫ
+LineBits sixInRowStarts(LineBits line) {
+    LineBits pair = line & (line >> 1);   // 2
+    LineBits quad = pair & (pair >> 2);   // 4
+    return quad & (pair >> 4);            // 6
+}
+
+// жposλϵǷĳ֮
+bool lineHasWinAt(LineBits line, int pos) {
+    LineBits starts = sixInRowStarts(line | (1u << pos));
+    int first = pos - (WIN_COUNT - 1);
+    if (first < 0) first = 0;
+    // [pos-5, pos]
+    LineBits window = ((2u << pos) - 1) & ~((1u << first) - 1);
+    return (starts & window) != 0;
+}
+
+// жplayer(row, col)ӺǷӣøplayerӼ㣩
+template <int N>
+bool Connect6<N>::bitboardCheckWin(const BitBoard* bb, int row, int col, ChessType player) {
+    STAT_ADD(EC_WIN_PROBES, 1);
+    int c = player - CT_BLACK;
+    return lineHasWinAt(bb->rows[c][row], col) ||
+           lineHasWinAt(bb->cols[c][col], row) ||
+           lineHasWinAt(bb->diags[c][row - col + BOARD_SIZE - 1], col) ||
+           lineHasWinAt(bb->antiDiags[c][row + col], col);
+}
+
+// (row, col)dirڵ߱żڵλ
+// ˳: 0ˮƽ1ֱ2Խߡ3Խ
+template <int N>
+void Connect6<N>::lineLocate(int dir, int row, int col, int* line, int* pos) {
+    switch (dir) {
+        case 0: *line = row; *pos = col; break;
+        case 1: *line = col; *pos = row; break;
+        case 2: *line = row - col + BOARD_SIZE - 1; *pos = col; break;
+        default: *line = row + col; *pos = col; break;
+    }
+}
+
+// lineLocate
+template <int N>
+void Connect6<N>::lineCell(int dir, int line, int pos, int* row, int* col) {
+    switch (dir) {
+        case 0: *row = line; *col = pos; break;
+        case 1: *row = pos; *col = line; break;
+        case 2: *row = pos + line - (BOARD_SIZE - 1); *col = pos; break;
+        default: *row = line - pos; *col = pos; break;
+    }
+}
+
+// ʵʴڵĸ[first, last]
+template <int N>
+void Connect6<N>::lineRange(int dir, int line, int* first, int* last) {
+    *first = 0;
+    *last = BOARD_SIZE - 1;
+    if (dir == 2) {
+        int diff = line - (BOARD_SIZE - 1);   // row - col
+        if (diff < 0) *first = -diff;
+        else *last = BOARD_SIZE - 1 - diff;
+    } else if (dir == 3) {
+        if (line > BOARD_SIZE - 1) *first = line - (BOARD_SIZE - 1);
+        else *last = line;
+    }
+}
+
+// ȡcdirlineϵλͼ
+template <int N>
+LineBits Connect6<N>::bitboardLine(const BitBoard* bb, int c, int dir, int line) {
+    switch (dir) {
+        case 0: return bb->rows[c][line];
+        case 1: return bb->cols[c][line];
+        case 2: return bb->diags[c][line];
+        default: return bb->antiDiags[c][line];
+    }
+}
+
+// ===== ͷ =====
+// ԴĿλΪȡ11񴰿ڣ5⿴ÿΪաӻ赲Էӻ⣩
+// һ53^5״̬һ赲֮ĸӲӰͣ淶ֻʣ63֣
+// 赲ǰĸΪreach0~5Ϊ 2^reach-1 reachмӵλͼ
+// ڵıΪ *HALF_SHAPES + Ҳ룬ڱ
+// ĵ6񴰿ۼӣû赲ʱӺ󴰿еļƷ֣
+// ӣ XX_XXһ౻סͶ׼ȷ֣һֻÿһα
+
+// δ赲񴰿nӣĸʱķ
+constexpr int windowScores[WIN_COUNT] = {1, 4, 20, 100, 1000, 10000};
+
+// bitsλλĸڿã
+constexpr int lowBitCount(int mask, int bits) {
+    int count = 0;
+    for (int k = 0; k < bits; k++) count += (mask >> k) & 1;
+    return count;
+}
+
+// һͱķ
+constexpr int shapeWindowScore(int shape) {
+    int reach[2] = {0, 0};
+    int own[2] = {0, 0};
+    int half[2] = {shape / HALF_SHAPES, shape % HALF_SHAPES};
+    for (int h = 0; h < 2; h++) {
+        while (half[h] >= (2 << reach[h]) - 1) reach[h]++;
+        own[h] = half[h] - ((1 << reach[h]) - 1);
+    }
+    
+    // ȡaҲȡ5-aĸһ񴰿
+    int score = 0;
+    for (int a = 0; a < WIN_COUNT; a++) {
+        int b = WIN_COUNT - 1 - a;
+        if (a > reach[0] || b > reach[1]) continue;
+        score += windowScores[lowBitCount(own[0], a) + lowBitCount(own[1], b)];
+    }
+    return score;
+}
+
+// ĸΪSHAPE_SIDEλ11񼺷λͼУǷоĸӣڿã
+constexpr bool windowHasSix(int window) {
+    for (int a = 0; a < WIN_COUNT; a++) {
+        int six = ((1 << WIN_COUNT) - 1) << a;
+        if ((window & six) == six && a <= SHAPE_SIDE && a + WIN_COUNT > SHAPE_SIDE) return true;
+    }
+    return false;
+}
+
+// ɵĲұ
+struct ShapeTables {
+    int score[SHAPE_COUNT];                        // ͱ -> 
+    unsigned char reverse[1 << SHAPE_SIDE];        // 5λλתȡĸ
+    bool six[1 << (2 * SHAPE_SIDE + 1)];           // 11񴰿ڵļλͼ -> Ƿ񾭹ĸ
+    
+    constexpr ShapeTables() : score(), reverse(), six() {
+        for (int i = 0; i < SHAPE_COUNT; i++) {
+            score[i] = shapeWindowScore(i);
+        }
+        for (int window = 0; window < (1 << (2 * SHAPE_SIDE + 1)); window++) {
+            six[window] = windowHasSix(window);
+        }
+        for (int mask = 0; mask < (1 << SHAPE_SIDE); mask++) {
+            int value = 0;
+            for (int k = 0; k < SHAPE_SIDE; k++) {
+                value |= ((mask >> k) & 1) << (SHAPE_SIDE - 1 - k);
+            }
+            reverse[mask] = (unsigned char)value;
+        }
+    }
+};
+constexpr ShapeTables shapeTables;
+
+// һ5Ĺ淶룬ownblockedĵiλӦi+1
+int halfShape(unsigned int own, unsigned int blocked) {
+    int reach = lowestBit(blocked | (1u << SHAPE_SIDE));
+    return ((1 << reach) - 1) + (int)(own & ((1u << reach) - 1));
+}
+
+// ¼һиڸ÷ϵͱ
+template <int N>
+void Connect6<N>::updateLineShapes(PatternCache* pc, const BitBoard* bb, int dir, int line, int first, int last) {
+    const unsigned int side = (1u << SHAPE_SIDE) - 1;
+    // λ˸SHAPE_SIDEλ⣨ĸӣ赲
+    unsigned int valid = (((2u << last) - 1) & ~((1u << first) - 1)) << SHAPE_SIDE;
+    for (int c = 0; c < 2; c++) {
+        unsigned int own = bitboardLine(bb, c, dir, line) << SHAPE_SIDE;
+        unsigned int blocked = ~valid | (bitboardLine(bb, 1 - c, dir, line) << SHAPE_SIDE);
+        for (int k = first; k <= last; k++) {
+            int row, col;
+            lineCell(dir, line, k, &row, &col);
+            // ڲλĵk+SHAPE_SIDEλ5ǵkk+4λҲǵk+6k+10λ
+            int left = halfShape(shapeTables.reverse[(own >> k) & side],
+                                 shapeTables.reverse[(blocked >> k) & side]);
+            int right = halfShape((own >> (k + SHAPE_SIDE + 1)) & side,
+                                  (blocked >> (k + SHAPE_SIDE + 1)) & side);
+            pc->shapes[c][dir][row * BOARD_SIZE + col] = (unsigned short)(left * HALF_SHAPES + right);
+        }
+    }
+}
+
+// õcڸøӺĳϵͷ
+template <int N>
+int Connect6<N>::shapeScore(const PatternCache* pc, int c, int row, int col, int dir) {
+    return shapeTables.score[pc->shapes[c][dir][row * BOARD_SIZE + col]];
+}
+
+// ¼ĳǷΪcĳ
+template <int N>
+void Connect6<N>::refreshWinCell(PatternCache* pc, int c, int row, int col) {
+    const LinePattern* cell = pc->cells[c][row][col];
+    bool win = false;
+    for (int d = 0; d < 4; d++) {
+        // countΪ0ӵĸӣ
+        if (cell[d].count > 0 && cell[d].run >= WIN_COUNT) win = true;
+    }
+    if (win) pc->winCells[c][row] |= 1u << col;
+    else pc->winCells[c][row] &= ~(1u << col);
+}
+
+// ¼һиڸ÷ϵͣɨ
+template <int N>
+void Connect6<N>::updateLinePatterns(PatternCache* pc, const BitBoard* bb, int dir, int line) {
+    int first, last;
+    lineRange(dir, line, &first, &last);
+    
+    for (int c = 0; c < 2; c++) {
+        LineBits own = bitboardLine(bb, c, dir, line);
+        LineBits opp = bitboardLine(bb, 1 - c, dir, line);
+        
+        // ÿڵ
+        int leftRun[BOARD_SIZE], rightRun[BOARD_SIZE];
+        for (int k = first, n = 0; k <= last; k++) {
+            leftRun[k] = n;
+            n = (own >> k & 1) ? n + 1 : 0;
+        }
+        for (int k = last, n = 0; k >= first; k--) {
+            rightRun[k] = n;
+            n = (own >> k & 1) ? n + 1 : 0;
+        }
+        
+        // ԷӰгɶΣͳƼͿλ
+        int start = first;
+        while (start <= last) {
+            int end = start;
+            int ownCount = 0;
+            while (end <= last && !(opp >> end & 1)) {
+                if (own >> end & 1) ownCount++;
+                end++;
+            }
+            int emptyCount = (end - start) - ownCount;
+            
+            for (int k = start; k <= end && k <= last; k++) {
+                int row, col;
+                lineCell(dir, line, k, &row, &col);
+                LinePattern* p = &pc->cells[c][row][col][dir];
+                if (k == end) {
+                    // Է
+                    p->count = p->empty = p->run = p->start = 0;
+                } else if (own >> k & 1) {
+                    // ûֻͣ¾ӣжϺȡɵһ
+                    p->count = p->empty = 0;
+                    p->run = (unsigned char)(leftRun[k] + rightRun[k] + 1);
+                    p->start = (unsigned char)(k - leftRun[k]);
+                } else {
+                    p->count = (unsigned char)(ownCount + 1);
+                    p->empty = (unsigned char)(emptyCount - 1);
+                    p->run = (unsigned char)(leftRun[k] + rightRun[k] + 1);
+                    p->start = (unsigned char)(k - leftRun[k]);
+                }
+                refreshWinCell(pc, c, row, col);
+            }
+            start = end + 1;
+        }
+    }
+    updateLineShapes(pc, bb, dir, line, first, last);
+}
+
+// λؽȫ
+template <int N>
+void Connect6<N>::patternCacheRebuild(PatternCache* pc, const BitBoard* bb) {
+    memset(pc, 0, sizeof(PatternCache));
+    for (int i = 0; i < BOARD_SIZE; i++) {
+        updateLinePatterns(pc, bb, 0, i);
+        updateLinePatterns(pc, bb, 1, i);
+    }
+    for (int i = 0; i < DIAG_COUNT; i++) {
+        updateLinePatterns(pc, bb, 2, i);
+        updateLinePatterns(pc, bb, 3, i);
+    }
+}
+
+// (row, col)ӻӺֻ¾
+template <int N>
+void Connect6<N>::patternCacheUpdate(PatternCache* pc, const BitBoard* bb, int row, int col) {
+    for (int d = 0; d < 4; d++) {
+        int line, pos;
+        lineLocate(d, row, col, &line, &pos);
+        updateLinePatterns(pc, bb, d, line);
+    }
+}
+
+// playerӼɻʤĿλ
+template <int N>
+bool Connect6<N>::findWinningCell(const PatternCache* pc, ChessType player, Position* pos) {
+    STAT_ADD(EC_WIN_PROBES, 1);
+    int c = player - CT_BLACK;
+    for (int i = 0; i < BOARD_SIZE; i++) {
+        if (pc->winCells[c][i]) {
+            pos->row = i;
+            pos->col = lowestBit(pc->winCells[c][i]);
+            return true;
+        }
+    }
+    return false;
+}
+
+// SplitMix64ù̶Zobrist֤ÿйϣһ
+unsigned long long splitMix64(unsigned long long* state) {
+    unsigned long long z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// ӺкųʼPCG32
+void rngSeed(Rng* rng, unsigned long long seed, unsigned long long stream) {
+    rng->state = 0;
+    rng->inc = (stream << 1) | 1;
+    rngNext(rng);
+    rng->state += seed;
+    rngNext(rng);
+}
+
+// PCG32XSH RRͬƽ״̬λλת
+unsigned int rngNext(Rng* rng) {
+    unsigned long long old = rng->state;
+    rng->state = old * 6364136223846793005ULL + rng->inc;
+    unsigned int xorshifted = (unsigned int)(((old >> 18) ^ old) >> 27);
+    unsigned int rot = (unsigned int)(old >> 59);
+    return (xorshifted >> rot) | (xorshifted << ((32 - rot) & 31));
+}
+
+// [0, bound)ڵó˷ȡ32λȡģûгboundԶС2^32ƫԺ
+unsigned int rngBounded(Rng* rng, unsigned int bound) {
+    return (unsigned int)(((unsigned long long)rngNext(rng) * bound) >> 32);
+}
+
+thread_local Rng threadRngState = {0, 0};   // incΪ0ʾûв
+
+// ̵߳һʹʱǰʱ̸̺߳Եĵַ
+Rng* threadRng() {
+    if (threadRngState.inc == 0) {
+        rngSeed(&threadRngState, (unsigned long long)nowNs(), (unsigned long long)(size_t)&threadRngState);
+    }
+    return &threadRngState;
+}
+
+// ʼZobristִֻһΣ̴С̹ͬûҲ
+template <int N>
+void Connect6<N>::initZobrist() {
+    // Ựڲͬ߳ͬʱ֣call_onceֻ֤һŷ
+    static std::once_flag once;
+    std::call_once(once, [] {
+        unsigned long long seed = 20240601ULL + N;
+        for (int c = 0; c < 2; c++) {
+            for (int i = 0; i < BOARD_SIZE; i++) {
+                for (int j = 0; j < BOARD_SIZE; j++) {
+                    zobristKeys[c][i][j] = splitMix64(&seed);
+                }
+            }
+        }
+        zobristSide = splitMix64(&seed);
+        zobristPairs = splitMix64(&seed);
+    });
+}
+
+// (row, col)ӺΧĺѡ
+template <int N>
+void Connect6<N>::candidateAdd(CandidateSet* cs, const BitBoard* bb, int row, int col) {
+    for (int i = row - CANDIDATE_RANGE; i <= row + CANDIDATE_RANGE; i++) {
+        if (i < 0 || i >= BOARD_SIZE) continue;
+        for (int j = col - CANDIDATE_RANGE; j <= col + CANDIDATE_RANGE; j++) {
+            if (j < 0 || j >= BOARD_SIZE) continue;
+            cs->nearStones[i][j]++;
+            cs->cells[i] |= 1u << j;
+        }
+        cs->cells[i] &= emptyBits(bb, i);
+    }
+}
+
+// (row, col)ӺΧĺѡ
+template <int N>
+void Connect6<N>::candidateRemove(CandidateSet* cs, int row, int col) {
+    for (int i = row - CANDIDATE_RANGE; i <= row + CANDIDATE_RANGE; i++) {
+        if (i < 0 || i >= BOARD_SIZE) continue;
+        for (int j = col - CANDIDATE_RANGE; j <= col + CANDIDATE_RANGE; j++) {
+            if (j < 0 || j >= BOARD_SIZE) continue;
+            if (--cs->nearStones[i][j] == 0) cs->cells[i] &= ~(1u << j);
+        }
+    }
+    if (cs->nearStones[row][col] > 0) cs->cells[row] |= 1u << col;
+}
+
+// ȡѡŷбŷʱֻԪ
+template <int N>
+int Connect6<N>::collectCandidates(const BoardState* bs, Position* moves) {
+    int count = 0;
+    for (int i = 0; i < BOARD_SIZE; i++) {
+        for (LineBits cells = bs->candidates.cells[i]; cells; cells &= cells - 1) {
+            moves[count].row = i;
+            moves[count].col = lowestBit(cells);
+            count++;
+        }
+    }
+    
+    int center = BOARD_SIZE / 2;
+    if (count == 0 && bitboardGet(&bs->bits, center, center) == CT_EMPTY) {
+        moves[0].row = center;
+        moves[0].col = center;
+        count = 1;
+    }
+    return count;
+}
+
+// վ
+template <int N>
+void Connect6<N>::boardReset(BoardState* bs) {
+    initZobrist();
+    bitboardReset(&bs->bits);
+    patternCacheRebuild(&bs->patterns, &bs->bits);
+    memset(&bs->candidates, 0, sizeof(CandidateSet));
+    bs->hash = 0;
+}
+
+// ӣͬλ̺ṹmake
+template <int N>
+void Connect6<N>::boardPlace(BoardState* bs, int row, int col, ChessType player) {
+    bitboardSet(&bs->bits, row, col, player);
+    patternCacheUpdate(&bs->patterns, &bs->bits, row, col);
+    candidateAdd(&bs->candidates, &bs->bits, row, col);
+    bs->hash ^= zobristKeys[player - CT_BLACK][row][col];
+}
+
+// ӣboardPlaceunmake
+template <int N>
+void Connect6<N>::boardRemove(BoardState* bs, int row, int col) {
+    ChessType player = bitboardGet(&bs->bits, row, col);
+    if (player == CT_EMPTY) return;
+    bitboardClear(&bs->bits, row, col);
+    patternCacheUpdate(&bs->patterns, &bs->bits, row, col);
+    candidateRemove(&bs->candidates, row, col);
+    bs->hash ^= zobristKeys[player - CT_BLACK][row][col];
+}
+
+// жplayer(row, col)ӺǷӣøǿλҲѾplayerӡ
+// ͻӺάÿÿϾӣֻĸrun
+// segmentΪNULLʱsegment[0]segment[1]ɵһε
+template <int N>
+bool Connect6<N>::boardCheckWin(const BoardState* bs, int row, int col, ChessType player, Position* segment) {
+    STAT_ADD(EC_WIN_PROBES, 1);
+    const LinePattern* cell = bs->patterns.cells[player - CT_BLACK][row][col];
+    for (int d = 0; d < 4; d++) {
+        if (cell[d].run >= WIN_COUNT) {
+            if (segment != NULL) {
+                int line, pos;
+                lineLocate(d, row, col, &line, &pos);
+                lineCell(d, line, cell[d].start, &segment[0].row, &segment[0].col);
+                lineCell(d, line, cell[d].start + cell[d].run - 1, &segment[1].row, &segment[1].col);
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+// ʼµһ
+template <int N>
+void Connect6<N>::resetGame(GameState* gs, RuleMode rule) {
+    boardReset(&gs->board);
+    gs->rule = rule;
+    gs->status = GS_PLAYING;
+    gs->currentPlayer = CT_BLACK;
+    gs->lastMove.row = -1;
+    gs->lastMove.col = -1;
+    gs->winLine[0] = gs->winLine[1] = gs->lastMove;
+    gs->moveCount = 0;
+    gs->historyLength = 0;
+}
+
+// player(row, col)ӣ¼ʷжʤʱfalse
+template <int N>
+bool Connect6<N>::playMove(GameState* gs, int row, int col, ChessType player) {
+    if (row < 0 || row >= BOARD_SIZE || col < 0 || col >= BOARD_SIZE) {
+        return false;
+    }
+    if (bitboardGet(&gs->board.bits, row, col) != CT_EMPTY || gs->status != GS_PLAYING) {
+        return false;
+    }
+    
+    boardPlace(&gs->board, row, col, player);
+    // ͻǰһͬʱʷԱ
+    int n = gs->moveCount;
+    if (n >= gs->historyLength || gs->moveHistory[n][0] != row || gs->moveHistory[n][1] != col) {
+        gs->moveHistory[n][0] = row;
+        gs->moveHistory[n][1] = col;
+        gs->historyLength = n + 1;
+    }
+    gs->moveCount++;
+    gs->lastMove.row = row;
+    gs->lastMove.col = col;
+    
+    // Ƿʤ
+    if (checkWin(gs, row, col, player, gs->winLine)) {
+        gs->status = (player == CT_BLACK) ? GS_BLACK_WIN : GS_WHITE_WIN;
+    } else if (isBoardFull(gs)) {
+        gs->status = GS_DRAW;
+    }
+    return true;
+}
+
+// 壺һӡboardRemoveԭṹʷ¼Ա
+template <int N>
+bool Connect6<N>::undoMove(GameState* gs) {
+    if (gs->moveCount == 0) {
+        return false;
+    }
+    
+    int n = --gs->moveCount;
+    boardRemove(&gs->board, gs->moveHistory[n][0], gs->moveHistory[n][1]);
+    
+    // Ծֻһغһص
+    gs->status = GS_PLAYING;
+    gs->winLine[0].row = gs->winLine[1].row = -1;
+    gs->winLine[0].col = gs->winLine[1].col = -1;
+    gs->currentPlayer = stoneOwner(gs->rule, n);
+    if (n > 0) {
+        gs->lastMove.row = gs->moveHistory[n - 1][0];
+        gs->lastMove.col = gs->moveHistory[n - 1][1];
+    } else {
+        gs->lastMove.row = -1;
+        gs->lastMove.col = -1;
+    }
+    return true;
+}
+
+// һλ峷ص
+template <int N>
+bool Connect6<N>::redoMove(GameState* gs) {
+    int n = gs->moveCount;
+    if (n >= gs->historyLength) {
+        return false;
+    }
+    if (!playMove(gs, gs->moveHistory[n][0], gs->moveHistory[n][1], stoneOwner(gs->rule, n))) {
+        return false;
+    }
+    if (gs->status == GS_PLAYING) {
+        gs->currentPlayer = stoneOwner(gs->rule, gs->moveCount);
+    }
+    return true;
+}
+
+// ж϶Ծplayer(row, col)ӺǷʤsegmentΪNULLboardCheckWin
+template <int N>
+bool Connect6<N>::checkWin(const GameState* gs, int row, int col, ChessType player, Position* segment) {
+    return boardCheckWin(&gs->board, row, col, player, segment);
+}
+
+// Ƿ
+template <int N>
+bool Connect6<N>::isBoardFull(const GameState* gs) {
+    return gs->moveCount >= BOARD_SIZE * BOARD_SIZE;
+}
+
+// stoneIndexӣ0ʼһ
+ChessType stoneOwner(RuleMode rule, int stoneIndex) {
+    if (rule == RULE_ONE_STONE) {
+        return (stoneIndex % 2 == 0) ? CT_BLACK : CT_WHITE;
+    }
+    // 1ӣ2ӣ2ӡ
+    if (stoneIndex == 0) return CT_BLACK;
+    return ((stoneIndex - 1) / 2 % 2 == 0) ? CT_WHITE : CT_BLACK;
+}
+
+// stonesPlayedʱֵһһֻҪ伸
+int stonesToPlay(RuleMode rule, int stonesPlayed) {
+    if (rule == RULE_ONE_STONE || stonesPlayed == 0) return 1;
+    return (stonesPlayed % 2 == 1) ? 2 : 1;
+}
+
+// =====  =====
+// һиӵʽownWeight*ĸ򼺷ͷ֮ + oppWeight*Էͷ֮ + bonus
+// ǺѡΪSCORE_NONEͱ밴ƽ̣AVX2ÿδ8gather
+// SSE2ûgatherֻȡֵ
+
+#define SCORE_NONE INT_MIN         // Ǻѡķ
+
+// λüӷֱеAIʹã
+template <int N>
+struct CellTables {
+    int centerBonus[Connect6<N>::CELL_STRIDE];
+    
+    constexpr CellTables() : centerBonus() {
+        for (int i = 0; i < N * N; i++) {
+            int dr = i / N - N / 2;
+            int dc = i % N - N / 2;
+            centerBonus[i] = (N - (dr < 0 ? -dr : dr) - (dc < 0 ? -dc : dc)) * 2;
+        }
+    }
+};
+template <int N> constexpr CellTables<N> cellTables{};
+
+#if defined(EVAL_AVX2)
+// ѡƽλͼiλӦi
+template <int N>
+void Connect6<N>::candidateFlatBits(const CandidateSet* cs, unsigned long long flat[CELL_WORDS]) {
+    for (int w = 0; w < CELL_WORDS; w++) flat[w] = 0;
+    for (int i = 0; i < BOARD_SIZE; i++) {
+        unsigned long long bits = cs->cells[i];
+        int pos = i * BOARD_SIZE;
+        flat[pos >> 6] |= bits << (pos & 63);
+        if ((pos & 63) + BOARD_SIZE > 64) flat[(pos >> 6) + 1] |= bits >> (64 - (pos & 63));
+    }
+}
+#endif
+
+// ӵļȨͷ֣汾
+template <int N>
+int Connect6<N>::weightedShapeScore(const PatternCache* pc, int c, int cell, int ownWeight, int oppWeight) {
+    int own = 0, opp = 0;
+    for (int d = 0; d < 4; d++) {
+        own += shapeTables.score[pc->shapes[c][d][cell]];
+        opp += shapeTables.score[pc->shapes[1 - c][d][cell]];
+    }
+    return own * ownWeight + opp * oppWeight;
+}
+
+// ˣscoresCELL_STRIDEԪأbonusΪNULL
+template <int N>
+void Connect6<N>::scoreCells(const BoardState* bs, ChessType player, int ownWeight, int oppWeight,
+                const int* bonus, int* scores) {
+    STAT_TIMER(ET_SCORING);
+    const PatternCache* pc = &bs->patterns;
+    int c = player - CT_BLACK;
+    
+#if defined(EVAL_AVX2)
+    unsigned long long flat[CELL_WORDS];
+    candidateFlatBits(&bs->candidates, flat);
+    const __m256i laneBits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    const __m256i ownW = _mm256_set1_epi32(ownWeight);
+    const __m256i oppW = _mm256_set1_epi32(oppWeight);
+    const __m256i none = _mm256_set1_epi32(SCORE_NONE);
+    for (int base = 0; base < CELL_STRIDE; base += 8) {
+        __m256i own = _mm256_setzero_si256();
+        __m256i opp = _mm256_setzero_si256();
+        for (int d = 0; d < 4; d++) {
+            __m256i ownShape = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)&pc->shapes[c][d][base]));
+            __m256i oppShape = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)&pc->shapes[1 - c][d][base]));
+            own = _mm256_add_epi32(own, _mm256_i32gather_epi32(shapeTables.score, ownShape, 4));
+            opp = _mm256_add_epi32(opp, _mm256_i32gather_epi32(shapeTables.score, oppShape, 4));
+        }
+        __m256i sum = _mm256_add_epi32(_mm256_mullo_epi32(own, ownW), _mm256_mullo_epi32(opp, oppW));
+        if (bonus) sum = _mm256_add_epi32(sum, _mm256_loadu_si256((const __m256i*)&bonus[base]));
+        
+        // ѡλͼ8λչ8ͨ
+        int bits = (int)((flat[base >> 6] >> (base & 63)) & 0xFF);
+        __m256i lanes = _mm256_and_si256(_mm256_set1_epi32(bits), laneBits);
+        __m256i isCandidate = _mm256_cmpeq_epi32(lanes, laneBits);
+        _mm256_storeu_si256((__m256i*)&scores[base], _mm256_blendv_epi8(none, sum, isCandidate));
+    }
+#else
+    // ûgatherָʱ̼㷴ֻѡֻѡ
+    for (int i = 0; i < CELL_STRIDE; i++) {
+        scores[i] = SCORE_NONE;
+    }
+    for (int row = 0; row < BOARD_SIZE; row++) {
+        for (LineBits cells = bs->candidates.cells[row]; cells; cells &= cells - 1) {
+            int i = row * BOARD_SIZE + lowestBit(cells);
+            scores[i] = weightedShapeScore(pc, c, i, ownWeight, oppWeight) + (bonus ? bonus[i] : 0);
+        }
+    }
+#endif
+}
+
+// ߵĸӣͬʱȡ±СģȵĵһȫΪSCORE_NONEʱ-1
+template <int N>
+int Connect6<N>::argmaxCells(const int* scores) {
+#if defined(EVAL_AVX2)
+    __m256i best = _mm256_loadu_si256((const __m256i*)scores);
+    for (int base = 8; base < CELL_STRIDE; base += 8) {
+        best = _mm256_max_epi32(best, _mm256_loadu_si256((const __m256i*)&scores[base]));
+    }
+    // ͨȽϵõȫֵҵһĸ
+    best = _mm256_max_epi32(best, _mm256_permute2x128_si256(best, best, 1));
+    best = _mm256_max_epi32(best, _mm256_shuffle_epi32(best, _MM_SHUFFLE(1, 0, 3, 2)));
+    best = _mm256_max_epi32(best, _mm256_shuffle_epi32(best, _MM_SHUFFLE(2, 3, 0, 1)));
+    int maxScore = _mm256_cvtsi256_si32(best);
+    if (maxScore == SCORE_NONE) return -1;
+    for (int base = 0; base < CELL_STRIDE; base += 8) {
+        __m256i equal = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)&scores[base]), best);
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(equal));
+        if (mask) return base + lowestBit((LineBits)mask);
+    }
+    return -1;
+#elif defined(EVAL_SSE2)
+    // SSE2û32λmaxñȽϼѡ
+    __m128i best = _mm_loadu_si128((const __m128i*)scores);
+    for (int base = 4; base < CELL_STRIDE; base += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i*)&scores[base]);
+        __m128i greater = _mm_cmpgt_epi32(v, best);
+        best = _mm_or_si128(_mm_and_si128(greater, v), _mm_andnot_si128(greater, best));
+    }
+    int lanes[4];
+    _mm_storeu_si128((__m128i*)lanes, best);
+    int maxScore = lanes[0];
+    for (int k = 1; k < 4; k++) {
+        if (lanes[k] > maxScore) maxScore = lanes[k];
+    }
+    if (maxScore == SCORE_NONE) return -1;
+    __m128i target = _mm_set1_epi32(maxScore);
+    for (int base = 0; base < CELL_STRIDE; base += 4) {
+        __m128i equal = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)&scores[base]), target);
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(equal));
+        if (mask) return base + lowestBit((LineBits)mask);
+    }
+    return -1;
+#else
+    int bestIndex = -1;
+    int maxScore = SCORE_NONE;
+    for (int i = 0; i < CELL_STRIDE; i++) {
+        if (scores[i] > maxScore) {
+            maxScore = scores[i];
+            bestIndex = i;
+        }
+    }
+    return bestIndex;
+#endif
+}
+
+// AI - Ӹĺѡоѡѡеkֱλͼҵ
+// ذѺѡȡñ̵߳߳ͬʱû
+template <int N>
+Position Connect6<N>::easyAIMove(const BoardState* bs, ChessType player) {
+    Position pos = {-1, -1};
+    (void)player;
+    
+    int total = 0;
+    for (int i = 0; i < BOARD_SIZE; i++) {
+        total += bitCount(bs->candidates.cells[i]);
+    }
+    if (total == 0) {
+        // Ԫ
+        int center = BOARD_SIZE / 2;
+        if (bitboardGet(&bs->bits, center, center) == CT_EMPTY) {
+            pos.row = center;
+            pos.col = center;
+        }
+        return pos;
+    }
+    
+    int k = (int)rngBounded(threadRng(), total);
+    for (int i = 0; i < BOARD_SIZE; i++) {
+        LineBits cells = bs->candidates.cells[i];
+        int count = bitCount(cells);
+        if (k < count) {
+            for (; k > 0; k--) cells &= cells - 1;
+            pos.row = i;
+            pos.col = lowestBit(cells);
+            break;
+        }
+        k -= count;
+    }
+    
+    return pos;
+}
+
+// еAI - 
+template <int N>
+Position Connect6<N>::mediumAIMove(const BoardState* bs, ChessType player) {
+    Position bestPos = {-1, -1};
+    ChessType opponent = (player == CT_BLACK) ? CT_WHITE : CT_BLACK;
+    
+    // 1. ԼǷʤ
+    if (findWinningCell(&bs->patterns, player, &bestPos)) {
+        return bestPos;
+    }
+    
+    // 2. ǷҪֹԷʤ
+    if (findWinningCell(&bs->patterns, opponent, &bestPos)) {
+        return bestPos;
+    }
+    
+    // 3. кѡ㣺طȽߣλüӷ
+    int scores[CELL_STRIDE];
+    scoreCells(bs, player, 1, 2, cellTables<N>.centerBonus, scores);
+    int best = argmaxCells(scores);
+    if (best >= 0) {
+        bestPos.row = best / BOARD_SIZE;
+        bestPos.col = best % BOARD_SIZE;
+    } else {
+        // ûкѡ㣬Ԫ
+        Position moves[MAX_MOVES];
+        if (collectCandidates(bs, moves) > 0) bestPos = moves[0];
+    }
+    
+    return bestPos;
+}
+
+// ǰʱ̣룩
+long long nowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// ǰʱ̣΢룩ͳƵʱ
+long long nowUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// ǰʱ̣룩ڻ׼
+long long nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// ֶμʱõʱûڼƽ̨
+unsigned long long statTicks() {
+#if defined(STAT_RDTSC)
+    return __rdtsc();
+#else
+    return (unsigned long long)nowNs();
+#endif
+}
+
+// ===== ͳ =====
+
+// ͼʱJSONе֣EngineCounterEngineTimer˳һ
+const char* const engineCounterNames[EC_COUNT] = {
+    "nodes", "threat_nodes", "win_probes", "move_gen", "evals", "tt_probes", "tt_hits", "tt_stores", "searches", "playouts"
+};
+const char* const engineTimerNames[ET_COUNT] = {"threats", "search", "scoring"};
+
+void statsMerge(EngineStats* into, const EngineStats* from) {
+    for (int i = 0; i < EC_COUNT; i++) into->counters[i] += from->counters[i];
+    for (int i = 0; i < ET_COUNT; i++) into->ticks[i] += from->ticks[i];
+}
+
+// ʼͳһ壺±߳ͳƵĿգ㣬Ƕ׻򽻴ʹöụ
+void profileBegin(MoveProfile* p) {
+    p->start = engineStats;
+    p->startNs = nowNs();
+    p->startTicks = statTicks();
+}
+
+void profileEnd(MoveProfile* p) {
+    p->ticks = statTicks() - p->startTicks;
+    p->wallNs = nowNs() - p->startNs;
+    for (int i = 0; i < EC_COUNT; i++) p->delta.counters[i] = engineStats.counters[i] - p->start.counters[i];
+    for (int i = 0; i < ET_COUNT; i++) p->delta.ticks[i] = engineStats.ticks[i] - p->start.ticks[i];
+    p->depth = (p->delta.counters[EC_SEARCHES] > 0) ? engineStats.depth : 0;
+    p->delta.depth = p->depth;
+}
+
+// һεʱһʵʱ
+long long profileTimerNs(const MoveProfile* p, EngineTimer timer) {
+    if (p->ticks == 0) return 0;
+    return (long long)((double)p->delta.ticks[timer] * p->wallNs / p->ticks);
+}
+
+// һͳдJSONֶΣ㻨ţ÷ģдĳ
+int profileFormat(const MoveProfile* p, char* buf, int size) {
+    int length = snprintf(buf, size, "\"wall_us\":%lld,\"depth\":%d", p->wallNs / 1000, p->depth);
+    for (int i = 0; i < EC_COUNT && length < size; i++) {
+        length += snprintf(buf + length, size - length, ",\"%s\":%lld", engineCounterNames[i], p->delta.counters[i]);
+    }
+    for (int i = 0; i < ET_COUNT && length < size; i++) {
+        length += snprintf(buf + length, size - length, ",\"%s_us\":%lld", engineTimerNames[i], profileTimerNs(p, (EngineTimer)i) / 1000);
+    }
+    return length;
+}
+
+// ֱͼͰţ0ڵ0Ͱ[2^(k-1), 2^k)ڵkͰĲһͰ
+int profileBucket(long long value) {
+    int bucket = 0;
+    while (value > 0 && bucket < PROFILE_BUCKETS - 1) {
+        value >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+// ֱͼƷλͰϽ
+long long profilePercentile(const long long* hist, int buckets, double q) {
+    long long total = 0;
+    for (int k = 0; k < buckets; k++) total += hist[k];
+    if (total == 0) return 0;
+    long long rank = (long long)(q * (total - 1));
+    for (int k = 0; k < buckets; k++) {
+        if (rank < hist[k]) return (k == 0) ? 0 : (1LL << k) - 1;
+        rank -= hist[k];
+    }
+    return (1LL << (buckets - 1)) - 1;
+}
+
+void summaryReset(ProfileSummary* s) {
+    memset(s, 0, sizeof(ProfileSummary));
+}
+
+void summaryAdd(ProfileSummary* s, const MoveProfile* p) {
+    s->moves++;
+    for (int i = 0; i < EC_COUNT; i++) s->totals[i] += p->delta.counters[i];
+    for (int i = 0; i < ET_COUNT; i++) s->timerNs[i] += profileTimerNs(p, (EngineTimer)i);
+    s->wallNs += p->wallNs;
+    s->timeHist[profileBucket(p->wallNs / 1000)]++;
+    s->nodeHist[profileBucket(p->delta.counters[EC_NODES] + p->delta.counters[EC_THREAT_NODES])]++;
+    s->depthHist[(p->depth < 0) ? 0 : (p->depth > MAX_PLY ? MAX_PLY : p->depth)]++;
+}
+
+void summaryMerge(ProfileSummary* into, const ProfileSummary* from) {
+    into->moves += from->moves;
+    for (int i = 0; i < EC_COUNT; i++) into->totals[i] += from->totals[i];
+    for (int i = 0; i < ET_COUNT; i++) into->timerNs[i] += from->timerNs[i];
+    into->wallNs += from->wallNs;
+    for (int k = 0; k < PROFILE_BUCKETS; k++) {
+        into->timeHist[k] += from->timeHist[k];
+        into->nodeHist[k] += from->nodeHist[k];
+    }
+    for (int d = 0; d <= MAX_PLY; d++) into->depthHist[d] += from->depthHist[d];
+}
+
+// ֱͼȥĩβĿͰдJSON
+int histogramFormat(char* buf, int size, const char* name, const long long* hist, int buckets) {
+    int used = buckets;
+    while (used > 1 && hist[used - 1] == 0) used--;
+    int length = snprintf(buf, size, ",\"%s\":[", name);
+    for (int k = 0; k < used && length < size; k++) {
+        length += snprintf(buf + length, size - length, k ? ",%lld" : "%lld", hist[k]);
+    }
+    if (length < size) length += snprintf(buf + length, size - length, "]");
+    return length;
+}
+
+// дJSONֶΣ㻨ţÿƽλֱͼдĳ
+int summaryFormat(const ProfileSummary* s, char* buf, int size) {
+    long long moves = (s->moves > 0) ? s->moves : 1;
+    int length = snprintf(buf, size, "\"moves\":%lld,\"wall_ms\":%lld", s->moves, s->wallNs / 1000000);
+    for (int i = 0; i < EC_COUNT && length < size; i++) {
+        length += snprintf(buf + length, size - length, ",\"%s\":%lld", engineCounterNames[i], s->totals[i]);
+    }
+    for (int i = 0; i < ET_COUNT && length < size; i++) {
+        length += snprintf(buf + length, size - length, ",\"%s_ms\":%lld", engineTimerNames[i], s->timerNs[i] / 1000000);
+    }
+    if (length < size) {
+        length += snprintf(buf + length, size - length,
+                           ",\"nodes_per_move\":%.1f,\"tt_hit_rate\":%.3f,\"time_us_p50\":%lld,\"time_us_p99\":%lld",
+                           (double)(s->totals[EC_NODES] + s->totals[EC_THREAT_NODES]) / moves,
+                           s->totals[EC_TT_PROBES] ? (double)s->totals[EC_TT_HITS] / s->totals[EC_TT_PROBES] : 0.0,
+                           profilePercentile(s->timeHist, PROFILE_BUCKETS, 0.5),
+                           profilePercentile(s->timeHist, PROFILE_BUCKETS, 0.99));
+    }
+    if (length < size) length += histogramFormat(buf + length, size - length, "time_us_hist", s->timeHist, PROFILE_BUCKETS);
+    if (length < size) length += histogramFormat(buf + length, size - length, "nodes_hist", s->nodeHist, PROFILE_BUCKETS);
+    if (length < size) length += histogramFormat(buf + length, size - length, "depth_hist", s->depthHist, MAX_PLY + 1);
+    return length;
+}
+
+// ŷõԼĽֵ϶ԶԷķؼֵ
+template <int N>
+int Connect6<N>::cellScore(const BoardState* bs, int row, int col, ChessType player) {
+    int c = player - CT_BLACK;
+    int score = 0;
+    for (int d = 0; d < 4; d++) {
+        score += shapeScore(&bs->patterns, c, row, col, d) + shapeScore(&bs->patterns, 1 - c, row, col, d);
+    }
+    int center = BOARD_SIZE / 2;
+    return score * 4 + BOARD_SIZE - abs(row - center) - abs(col - center);
+}
+
+// ֵ̬playerʱ˫кѡϵǱ֮
+template <int N>
+int Connect6<N>::evaluateBoard(const BoardState* bs, ChessType player) {
+    STAT_ADD(EC_EVALS, 1);
+#if defined(EVAL_AVX2)
+    // AVX2ʱ˱ѡ
+    int scores[CELL_STRIDE];
+    scoreCells(bs, player, 1, -1, NULL, scores);
+    int score = 0;
+    for (int i = 0; i < CELL_STRIDE; i++) {
+        if (scores[i] != SCORE_NONE) score += scores[i];
+    }
+    return score;
+#else
+    STAT_TIMER(ET_SCORING);
+    int c = player - CT_BLACK;
+    int score = 0;
+    for (int i = 0; i < BOARD_SIZE; i++) {
+        for (LineBits cells = bs->candidates.cells[i]; cells; cells &= cells - 1) {
+            int j = lowestBit(cells);
+            for (int d = 0; d < 4; d++) {
+                score += shapeScore(&bs->patterns, c, i, j, d) - shapeScore(&bs->patterns, 1 - c, i, j, d);
+            }
+        }
+    }
+    return score;
+#endif
+}
+
+// ӸߵͲ룬ǰmaxMovesµĸ
+int insertScored(ScoredMove* moves, int count, int maxMoves, Position pos, int score) {
+    if (count == maxMoves && score <= moves[count - 1].score) return count;
+    int k = (count < maxMoves) ? count++ : count - 1;
+    while (k > 0 && moves[k - 1].score < score) {
+        moves[k] = moves[k - 1];
+        k--;
+    }
+    moves[k].pos = pos;
+    moves[k].score = score;
+    return count;
+}
+
+// ɰӸߵŷŷ
+// Էгʱֻɶµ
+template <int N>
+int Connect6<N>::generateMoves(const BoardState* bs, ChessType player, ScoredMove* moves, int maxMoves) {
+    STAT_ADD(EC_MOVE_GEN, 1);
+    STAT_TIMER(ET_SCORING);
+    int c = player - CT_BLACK;
+    int count = 0;
+    
+    for (int i = 0; i < BOARD_SIZE; i++) {
+        LineBits cells = bs->patterns.winCells[1 - c][i];
+        for (; cells && count < maxMoves; cells &= cells - 1) {
+            moves[count].pos.row = i;
+            moves[count].pos.col = lowestBit(cells);
+            moves[count].score = 0;
+            count++;
+        }
+    }
+    if (count > 0) return count;
+    
+    // ߵmaxMovesѡ
+    Position candidates[MAX_MOVES];
+    int candidateCount = collectCandidates(bs, candidates);
+    for (int n = 0; n < candidateCount; n++) {
+        Position pos = candidates[n];
+        count = insertScored(moves, count, maxMoves, pos, cellScore(bs, pos.row, pos.col, player));
+    }
+    return count;
+}
+
+// ڴԤ㣨MB·ûͰȡԤ2
+bool ttResize(TranspositionTable* table, size_t megabytes) {
+    size_t count = 1;
+    while (count * 2 * sizeof(TTBucket) <= megabytes * 1024 * 1024) count *= 2;
+    
+    TTBucket* buckets = new (std::nothrow) TTBucket[count];
+    if (buckets == NULL) return false;
+    delete[] table->buckets;
+    table->buckets = buckets;
+    table->bucketCount = count;
+    ttClear(table);
+    return true;
+}
+
+// ͷûռõڴ棬֮ҪttResizeʹ
+void ttRelease(TranspositionTable* table) {
+    delete[] table->buckets;
+    table->buckets = NULL;
+    table->bucketCount = 0;
+}
+
+// û
+void ttClear(TranspositionTable* table) {
+    for (size_t i = 0; i < table->bucketCount; i++) {
+        for (int k = 0; k < TT_BUCKET_SIZE; k++) {
+            table->buckets[i].entries[k].check.store(0, std::memory_order_relaxed);
+            table->buckets[i].entries[k].data.store(0, std::memory_order_relaxed);
+        }
+    }
+    table->age = 0;
+}
+
+// ʼһıȱ滻
+void ttNewSearch(TranspositionTable* table) {
+    table->age.store((table->age.load() + 1) & 0x3F);
+}
+
+// : 32λ | 16λŷСи8λ̴С޹أ | 8λ | 2λ߽ | 6λ
+unsigned long long ttPack(int score, int depth, BoundType bound, Position move, unsigned int age) {
+    unsigned int moveIndex = (move.row < 0) ? 0xFFFF : (unsigned int)(move.row << 8 | move.col);
+    return (unsigned long long)(unsigned int)score |
+           (unsigned long long)moveIndex << 32 |
+           (unsigned long long)(depth & 0xFF) << 48 |
+           (unsigned long long)bound << 56 |
+           (unsigned long long)(age & 0x3F) << 58;
+}
+
+// ѯûʱout
+bool ttProbe(const TranspositionTable* table, unsigned long long key, TTData* out) {
+    if (table->buckets == NULL) return false;
+    STAT_ADD(EC_TT_PROBES, 1);
+    const TTBucket* bucket = &table->buckets[key & (table->bucketCount - 1)];
+    for (int k = 0; k < TT_BUCKET_SIZE; k++) {
+        unsigned long long data = bucket->entries[k].data.load(std::memory_order_relaxed);
+        unsigned long long check = bucket->entries[k].check.load(std::memory_order_relaxed);
+        if (data == 0 || (check ^ data) != key) continue;
+        
+        unsigned int moveIndex = (unsigned int)(data >> 32) & 0xFFFF;
+        out->score = (int)(unsigned int)data;
+        out->depth = (int)(data >> 48) & 0xFF;
+        out->bound = (BoundType)((data >> 56) & 0x3);
+        out->move.row = (moveIndex == 0xFFFF) ? -1 : (int)(moveIndex >> 8);
+        out->move.col = (moveIndex == 0xFFFF) ? -1 : (int)(moveIndex & 0xFF);
+        STAT_ADD(EC_TT_HITS, 1);
+        return true;
+    }
+    return false;
+}
+
+// дûͬһֱӸǣ滻Ͱɡǳı
+void ttStore(TranspositionTable* table, unsigned long long key, int depth,
+             BoundType bound, int score, Position move) {
+    if (table->buckets == NULL) return;
+    STAT_ADD(EC_TT_STORES, 1);
+    TTBucket* bucket = &table->buckets[key & (table->bucketCount - 1)];
+    TTEntry* victim = &bucket->entries[0];
+    int victimValue = 1 << 30;
+    
+    for (int k = 0; k < TT_BUCKET_SIZE; k++) {
+        TTEntry* entry = &bucket->entries[k];
+        unsigned long long data = entry->data.load(std::memory_order_relaxed);
+        unsigned long long check = entry->check.load(std::memory_order_relaxed);
+        if (data == 0 || (check ^ data) == key) {
+            victim = entry;
+            break;
+        }
+        int value = (int)(data >> 48 & 0xFF);
+        if (((data >> 58) & 0x3F) != table->age) value -= 256;
+        if (value < victimValue) {
+            victimValue = value;
+            victim = entry;
+        }
+    }
+    
+    unsigned long long data = ttPack(score, depth, bound, move, table->age);
+    victim->check.store(key ^ data, std::memory_order_relaxed);
+    victim->data.store(data, std::memory_order_relaxed);
+}
+
+// ʤйأûʱԵǰڵֵ
+int scoreToTT(int score, int ply) {
+    if (score >= WIN_SCORE - MAX_PLY) return score + ply;
+    if (score <= -WIN_SCORE + MAX_PLY) return score - ply;
+    return score;
+}
+
+int scoreFromTT(int score, int ply) {
+    if (score >= WIN_SCORE - MAX_PLY) return score - ply;
+    if (score <= -WIN_SCORE + MAX_PLY) return score + ply;
+    return score;
+}
+
+// ûеļӹϣֵһ
+template <int N>
+unsigned long long Connect6<N>::positionKey(const BoardState* bs, ChessType player) {
+    return bs->hash ^ (player == CT_WHITE ? zobristSide : 0);
+}
+
+// ֵAlpha-Betaֵplayerʱľ
+template <int N>
+int Connect6<N>::negamax(SearchContext* ctx, int depth, int alpha, int beta, ChessType player, int ply) {
+    ctx->nodes++;
+    if ((ctx->nodes & 1023) == 0 &&
+        (nowMs() >= ctx->deadline || (ctx->cancel && ctx->cancel->load(std::memory_order_relaxed)))) {
+        ctx->abort->store(true, std::memory_order_relaxed);
+    }
+    if (ctx->abort->load(std::memory_order_relaxed)) ctx->stopped = true;
+    if (ctx->stopped) return 0;
+    
+    ChessType opponent = (player == CT_BLACK) ? CT_WHITE : CT_BLACK;
+    Position win;
+    if (findWinningCell(&ctx->board.patterns, player, &win)) {
+        return WIN_SCORE - ply;
+    }
+    
+    // ȷʱ
+    if (findWinningCell(&ctx->board.patterns, opponent, &win) && ply < MAX_PLY) depth++;
+    if (depth <= 0 || ply >= MAX_PLY) return evaluateBoard(&ctx->board, player);
+    
+    // û㹻ʱֱʹ
+    unsigned long long key = positionKey(&ctx->board, player);
+    TTData entry;
+    Position hashMove = {-1, -1};
+    if (ttProbe(&tt, key, &entry)) {
+        hashMove = entry.move;
+        if (entry.depth >= depth) {
+            int score = scoreFromTT(entry.score, ply);
+            if (entry.bound == TT_EXACT) return score;
+            if (entry.bound == TT_LOWER && score >= beta) return score;
+            if (entry.bound == TT_UPPER && score <= alpha) return score;
+        }
+    }
+    
+    ScoredMove moves[SEARCH_BRANCH];
+    int moveCount = generateMoves(&ctx->board, player, moves, SEARCH_BRANCH);
+    if (moveCount == 0) return 0;
+    
+    // ûеŷǰ
+    for (int i = 1; i < moveCount; i++) {
+        if (moves[i].pos.row == hashMove.row && moves[i].pos.col == hashMove.col) {
+            ScoredMove first = moves[i];
+            for (int k = i; k > 0; k--) moves[k] = moves[k - 1];
+            moves[0] = first;
+            break;
+        }
+    }
+    
+    int alphaOrig = alpha;
+    int best = -WIN_SCORE;
+    Position bestMove = moves[0].pos;
+    for (int i = 0; i < moveCount; i++) {
+        Position m = moves[i].pos;
+        boardPlace(&ctx->board, m.row, m.col, player);
+        int score = -negamax(ctx, depth - 1, -beta, -alpha, opponent, ply + 1);
+        boardRemove(&ctx->board, m.row, m.col);
+        if (ctx->stopped) return 0;
+        
+        if (score > best) {
+            best = score;
+            bestMove = m;
+        }
+        if (best > alpha) alpha = best;
+        if (alpha >= beta) break;
+    }
+    
+    BoundType bound = (best >= beta) ? TT_LOWER : (best > alphaOrig) ? TT_EXACT : TT_UPPER;
+    ttStore(&tt, key, depth, bound, scoreToTT(best, ply), bestMove);
+    return best;
+}
+
+// ̵߳ĵctx
+// ̴߳Ӳͬ𲽣̴߳ͨûýLazy SMP
+template <int N>
+void Connect6<N>::iterativeDeepening(SearchContext* ctx, ChessType player) {
+    ChessType opponent = (player == CT_BLACK) ? CT_WHITE : CT_BLACK;
+    ScoredMove moves[SEARCH_BRANCH];
+    int moveCount = generateMoves(&ctx->board, player, moves, SEARCH_BRANCH);
+    if (moveCount == 0) return;
+    ctx->bestMove = moves[0].pos;
+    
+    for (int depth = 1 + ctx->threadIndex % 2; depth <= ctx->maxDepth; depth++) {
+        int alpha = -WIN_SCORE - 1;
+        int bestIndex = 0;
+        
+        for (int i = 0; i < moveCount; i++) {
+            Position m = moves[i].pos;
+            boardPlace(&ctx->board, m.row, m.col, player);
+            int score = -negamax(ctx, depth - 1, -WIN_SCORE - 1, -alpha, opponent, 1);
+            boardRemove(&ctx->board, m.row, m.col);
+            if (ctx->stopped) break;
+            
+            if (score > alpha) {
+                alpha = score;
+                bestIndex = i;
+            }
+        }
+        if (ctx->stopped) break;
+        
+        // ŷƵǰһ
+        ScoredMove best = moves[bestIndex];
+        for (int i = bestIndex; i > 0; i--) moves[i] = moves[i - 1];
+        moves[0] = best;
+        ctx->bestMove = best.pos;
+        ctx->bestScore = alpha;
+        ctx->completedDepth = depth;
+        if (ctx->progress) {
+            ctx->progress->move.store(best.pos.row * BOARD_SIZE + best.pos.col);
+            ctx->progress->depth.store(depth);
+        }
+        ttStore(&tt, positionKey(&ctx->board, player), depth, TT_EXACT, alpha, best.pos);
+        
+        // ѾҵʤذܾͲؼ
+        if (alpha >= WIN_SCORE - MAX_PLY || alpha <= -WIN_SCORE + MAX_PLY) break;
+        
+        // һͨʱ䳤öֹ࣬ʱֱ̾ӷأʱ˷ĵ
+        if (nowMs() >= ctx->softDeadline) break;
+    }
+}
+
+// ̣߳ͳƴ㿪ʼۼƣʱctx̺߳ϲ
+template <int N>
+void Connect6<N>::searchThread(SearchContext* ctx, ChessType player, bool pairs) {
+    memset(&engineStats, 0, sizeof(engineStats));
+    if (pairs) {
+        pairIterativeDeepening(ctx, player);
+    } else {
+        iterativeDeepening(ctx, player);
+    }
+    ctx->stats = engineStats;
+}
+
+// ʱroot棬һŷpairsΪtrueʱ˫һ
+// ߳ʱ߳ͬһ沢ûֹ֪߳̽ͨ߳ͣ
+template <int N>
+SearchResult Connect6<N>::runSearch(const BoardState* root, ChessType player, const SearchLimits* limits, bool pairs) {
+    STAT_TIMER(ET_SEARCH);
+    long long start = nowMs();
+    int threadCount = limits->threads;
+    if (threadCount < 1) threadCount = 1;
+    if (threadCount > MAX_SEARCH_THREADS) threadCount = MAX_SEARCH_THREADS;
+    
+    std::atomic<bool> abort(false);
+    SearchContext* contexts = new SearchContext[threadCount];
+    for (int i = 0; i < threadCount; i++) {
+        SearchContext* ctx = &contexts[i];
+        ctx->board = *root;
+        ctx->nodes = 0;
+        ctx->deadline = (limits->timeLimitMs > 0) ? start + limits->timeLimitMs : LLONG_MAX;
+        ctx->softDeadline = (limits->timeLimitMs > 0) ? start + limits->timeLimitMs / 2 : LLONG_MAX;
+        ctx->stopped = false;
+        ctx->abort = &abort;
+        ctx->cancel = limits->cancel;
+        ctx->progress = (i == 0) ? limits->progress : NULL;
+        ctx->threadIndex = i;
+        ctx->maxDepth = limits->maxDepth;
+        ctx->completedDepth = 0;
+        ctx->bestScore = 0;
+        ctx->bestMove.row = -1;
+        ctx->bestMove.col = -1;
+        ctx->bestSecond.row = -1;
+        ctx->bestSecond.col = -1;
+    }
+    ttNewSearch(&tt);
+    
+    std::thread* helpers = new std::thread[threadCount];
+    for (int i = 1; i < threadCount; i++) {
+        helpers[i] = std::thread(searchThread, &contexts[i], player, pairs);
+    }
+    if (pairs) {
+        pairIterativeDeepening(&contexts[0], player);
+    } else {
+        iterativeDeepening(&contexts[0], player);
+    }
+    abort.store(true);
+    for (int i = 1; i < threadCount; i++) {
+        helpers[i].join();
+#if ENGINE_STATS
+        statsMerge(&engineStats, &contexts[i].stats);
+#endif
+    }
+    
+    // ȡ̵߳Ľͬʱ߳Ϊ׼
+    SearchResult result;
+    int chosen = 0;
+    result.nodes = 0;
+    for (int i = 0; i < threadCount; i++) {
+        result.nodes += contexts[i].nodes;
+        if (contexts[i].completedDepth > contexts[chosen].completedDepth) chosen = i;
+    }
+    result.bestMove = contexts[chosen].bestMove;
+    result.secondMove = contexts[chosen].bestSecond;
+    result.score = contexts[chosen].bestScore;
+    result.depth = contexts[chosen].completedDepth;
+    result.timeMs = nowMs() - start;
+    STAT_ADD(EC_SEARCHES, 1);
+    STAT_ADD(EC_NODES, result.nodes);
+#if ENGINE_STATS
+    engineStats.depth = result.depth;
+#endif
+    
+    delete[] helpers;
+    delete[] contexts;
+    return result;
+}
+
+template <int N>
+SearchResult Connect6<N>::searchPosition(const BoardState* root, ChessType player, const SearchLimits* limits) {
+    return runSearch(root, player, limits, false);
+}
+
+// ===== ˫ӹ =====
+// ׼ÿӣֱöϻ÷֧ɵӵƽ
+// һֻȡߵļѡ㣻ԷһӳʱֻӶµȡ
+// ڶڵһº´ֻ֣ǵһӵĺѡ͵һӸӰĸӣ
+
+// player˵(row, col)Ƿĳ"Ӿͳ"Ĵ
+// ͷﺬĸӵĴڼwindowScores[4]֣രڼҲ
+template <int N>
+bool Connect6<N>::hasPairThreatWindow(const BoardState* bs, int c, int row, int col) {
+    for (int d = 0; d < 4; d++) {
+        if (shapeScore(&bs->patterns, c, row, col, d) >= windowScores[WIN_COUNT - 2]) return true;
+    }
+    return false;
+}
+
+// playerһӾܳпλԷռݵĶµ㣩ظ
+template <int N>
+int Connect6<N>::collectPairThreats(const BoardState* bs, ChessType player, Position* cells, int maxCells) {
+    int c = player - CT_BLACK;
+    int count = 0;
+    for (int i = 0; i < BOARD_SIZE && count < maxCells; i++) {
+        for (LineBits row = bs->candidates.cells[i]; row && count < maxCells; row &= row - 1) {
+            int j = lowestBit(row);
+            if (hasPairThreatWindow(bs, c, i, j)) {
+                cells[count].row = i;
+                cells[count].col = j;
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+// playerһֱܷӳһӻӣдpair
+template <int N>
+bool Connect6<N>::findPairWin(BoardState* bs, ChessType player, StonePair* pair) {
+    Position cell;
+    if (findWinningCell(&bs->patterns, player, &cell)) {
+        pair->first = cell;
+        pair->second.row = -1;
+        pair->second.col = -1;
+        return true;
+    }
+    
+    Position threat;
+    if (collectPairThreats(bs, player, &threat, 1) == 0) return false;
+    boardPlace(bs, threat.row, threat.col, player);
+    bool win = findWinningCell(&bs->patterns, player, &cell);
+    boardRemove(bs, threat.row, threat.col);
+    if (win) {
+        pair->first = threat;
+        pair->second = cell;
+    }
+    return win;
+}
+
+// һѾfirstΪplayerѡڶӣظ
+// Էӳвʱֻܶ£ڶfirstΧ5x5Χʹڣĺѡ´
+template <int N>
+int Connect6<N>::pickSecondStones(BoardState* bs, ChessType player, Position first, const ScoredMove* shortlist,
+                                  int shortlistCount, ScoredMove* seconds) {
+    STAT_TIMER(ET_SCORING);
+    ChessType opponent = (player == CT_BLACK) ? CT_WHITE : CT_BLACK;
+    int count = 0;
+    
+    Position threats[MAX_MOVES];
+    int threatCount = collectPairThreats(bs, opponent, threats, MAX_MOVES);
+    if (threatCount > 0) {
+        for (int k = 0; k < threatCount; k++) {
+            count = insertScored(seconds, count, PAIR_SECOND, threats[k],
+                                 cellScore(bs, threats[k].row, threats[k].col, player));
+        }
+        return count;
+    }
+    
+    LineBits seen[BOARD_SIZE] = {0};
+    seen[first.row] |= 1u << first.col;
+    for (int k = 0; k < shortlistCount; k++) {
+        Position p = shortlist[k].pos;
+        if (seen[p.row] >> p.col & 1) continue;
+        seen[p.row] |= 1u << p.col;
+        count = insertScored(seconds, count, PAIR_SECOND, p, cellScore(bs, p.row, p.col, player));
+    }
+    for (int dr = -SHAPE_SIDE; dr <= SHAPE_SIDE; dr++) {
+        int i = first.row + dr;
+        if (i < 0 || i >= BOARD_SIZE) continue;
+        for (int dc = -SHAPE_SIDE; dc <= SHAPE_SIDE; dc++) {
+            int j = first.col + dc;
+            if (j < 0 || j >= BOARD_SIZE) continue;
+            bool near = abs(dr) <= CANDIDATE_RANGE && abs(dc) <= CANDIDATE_RANGE;
+            bool onLine = dr == 0 || dc == 0 || dr == dc || dr == -dc;
+            if (!near && !onLine) continue;
+            if (!(bs->candidates.cells[i] >> j & 1) || (seen[i] >> j & 1)) continue;
+            seen[i] |= 1u << j;
+            Position p = {i, j};
+            count = insertScored(seconds, count, PAIR_SECOND, p, cellScore(bs, i, j, player));
+        }
+    }
+    return count;
+}
+
+// ɰӸߵϣ
+// bsںʱӣʱָԭ
+template <int N>
+int Connect6<N>::generatePairs(BoardState* bs, ChessType player, ScoredPair* pairs, int maxPairs) {
+    ChessType opponent = (player == CT_BLACK) ? CT_WHITE : CT_BLACK;
+    ScoredMove shortlist[PAIR_SHORTLIST];
+    int shortlistCount = 0;
+    
+    // ԷһӳʱһֻܴӶµѡ
+    Position threats[MAX_MOVES];
+    int threatCount = collectPairThreats(bs, opponent, threats, MAX_MOVES);
+    if (threatCount > 0) {
+        for (int k = 0; k < threatCount; k++) {
+            shortlistCount = insertScored(shortlist, shortlistCount, PAIR_SHORTLIST, threats[k],
+                                          cellScore(bs, threats[k].row, threats[k].col, player));
+        }
+    } else {
+        shortlistCount = generateMoves(bs, player, shortlist, PAIR_SHORTLIST);
+    }
+    
+    int firstCount = (shortlistCount < PAIR_FIRST) ? shortlistCount : PAIR_FIRST;
+    int count = 0;
+    for (int f = 0; f < firstCount; f++) {
+        Position first = shortlist[f].pos;
+        ScoredMove seconds[PAIR_SECOND];
+        boardPlace(bs, first.row, first.col, player);
+        int secondCount = pickSecondStones(bs, player, first, shortlist, shortlistCount, seconds);
+        boardRemove(bs, first.row, first.col);
+        
+        for (int s = 0; s < secondCount; s++) {
+            Position second = seconds[s].pos;
+            int score = shortlist[f].score + seconds[s].score;
+            
+            // ͬһӿܴһӸһ
+            bool seen = false;
+            for (int k = 0; k < count && !seen; k++) {
+                seen = pairs[k].pair.first.row == second.row && pairs[k].pair.first.col == second.col &&
+                       pairs[k].pair.second.row == first.row && pairs[k].pair.second.col == first.col;
+            }
+            if (seen || (count == maxPairs && score <= pairs[count - 1].score)) continue;
+            
+            int k = (count < maxPairs) ? count++ : count - 1;
+            while (k > 0 && pairs[k - 1].score < score) {
+                pairs[k] = pairs[k - 1];
+                k--;
+            }
+            pairs[k].pair.first = first;
+            pairs[k].pair.second = second;
+            pairs[k].score = score;
+        }
+        
+        // ֻʣһλ
+        if (secondCount == 0 && count < maxPairs) {
+            pairs[count].pair.first = first;
+            pairs[count].pair.second.row = -1;
+            pairs[count].pair.second.col = -1;
+            pairs[count].score = shortlist[f].score;
+            count++;
+        }
+    }
+    return count;
+}
+
+// ˫һֵ
+template <int N>
+void Connect6<N>::placePair(BoardState* bs, const StonePair* pair, ChessType player) {
+    boardPlace(bs, pair->first.row, pair->first.col, player);
+    if (pair->second.row >= 0) boardPlace(bs, pair->second.row, pair->second.col, player);
+}
+
+template <int N>
+void Connect6<N>::removePair(BoardState* bs, const StonePair* pair) {
+    if (pair->second.row >= 0) boardRemove(bs, pair->second.row, pair->second.col);
+    boardRemove(bs, pair->first.row, pair->first.col);
+}
+
+// ˫ӹĸֵÿһһ֣ӣdepth
+template <int N>
+int Connect6<N>::pairNegamax(SearchContext* ctx, int depth, int alpha, int beta, ChessType player, int ply) {
+    ctx->nodes++;
+    if ((ctx->nodes & 1023) == 0 &&
+        (nowMs() >= ctx->deadline || (ctx->cancel && ctx->cancel->load(std::memory_order_relaxed)))) {
+        ctx->abort->store(true, std::memory_order_relaxed);
+    }
+    if (ctx->abort->load(std::memory_order_relaxed)) ctx->stopped = true;
+    if (ctx->stopped) return 0;
+    
+    ChessType opponent = (player == CT_BLACK) ? CT_WHITE : CT_BLACK;
+    StonePair win;
+    if (findPairWin(&ctx->board, player, &win)) {
+        return WIN_SCORE - ply;
+    }
+    if (depth <= 0 || ply >= MAX_PLY) return evaluateBoard(&ctx->board, player);
+    
+    // ûֻ¼һӣ
+    unsigned long long key = positionKey(&ctx->board, player) ^ zobristPairs;
+    TTData entry;
+    Position hashMove = {-1, -1};
+    if (ttProbe(&tt, key, &entry)) {
+        hashMove = entry.move;
+        if (entry.depth >= depth) {
+            int score = scoreFromTT(entry.score, ply);
+            if (entry.bound == TT_EXACT) return score;
+            if (entry.bound == TT_LOWER && score >= beta) return score;
+            if (entry.bound == TT_UPPER && score <= alpha) return score;
+        }
+    }
+    
+    ScoredPair pairs[PAIR_BRANCH];
+    int pairCount = generatePairs(&ctx->board, player, pairs, PAIR_BRANCH);
+    if (pairCount == 0) return 0;
+    
+    for (int i = 1; i < pairCount; i++) {
+        if (pairs[i].pair.first.row == hashMove.row && pairs[i].pair.first.col == hashMove.col) {
+            ScoredPair first = pairs[i];
+            for (int k = i; k > 0; k--) pairs[k] = pairs[k - 1];
+            pairs[0] = first;
+            break;
+        }
+    }
+    
+    int alphaOrig = alpha;
+    int best = -WIN_SCORE;
+    Position bestMove = pairs[0].pair.first;
+    for (int i = 0; i < pairCount; i++) {
+        placePair(&ctx->board, &pairs[i].pair, player);
+        int score = -pairNegamax(ctx, depth - 1, -beta, -alpha, opponent, ply + 1);
+        removePair(&ctx->board, &pairs[i].pair);
+        if (ctx->stopped) return 0;
+        
+        if (score > best) {
+            best = score;
+            bestMove = pairs[i].pair.first;
+        }
+        if (best > alpha) alpha = best;
+        if (alpha >= beta) break;
+    }
+    
+    BoundType bound = (best >= beta) ? TT_LOWER : (best > alphaOrig) ? TT_EXACT : TT_UPPER;
+    ttStore(&tt, key, depth, bound, scoreToTT(best, ply), bestMove);
+    return best;
+}
+
+// ˫ӹµ̵߳ĵiterativeDeepeningֻͬÿչ
+template <int N>
+void Connect6<N>::pairIterativeDeepening(SearchContext* ctx, ChessType player) {
+    ChessType opponent = (player == CT_BLACK) ? CT_WHITE : CT_BLACK;
+    ScoredPair pairs[PAIR_BRANCH];
+    int pairCount = generatePairs(&ctx->board, player, pairs, PAIR_BRANCH);
+    if (pairCount == 0) return;
+    ctx->bestMove = pairs[0].pair.first;
+    ctx->bestSecond = pairs[0].pair.second;
+    
+    for (int depth = 1 + ctx->threadIndex % 2; depth <= ctx->maxDepth; depth++) {
+        int alpha = -WIN_SCORE - 1;
+        int bestIndex = 0;
+        
+        for (int i = 0; i < pairCount; i++) {
+            placePair(&ctx->board, &pairs[i].pair, player);
+            int score = -pairNegamax(ctx, depth - 1, -WIN_SCORE - 1, -alpha, opponent, 1);
+            removePair(&ctx->board, &pairs[i].pair);
+            if (ctx->stopped) break;
+            
+            if (score > alpha) {
+                alpha = score;
+                bestIndex = i;
+            }
+        }
+        if (ctx->stopped) break;
+        
+        ScoredPair best = pairs[bestIndex];
+        for (int i = bestIndex; i > 0; i--) pairs[i] = pairs[i - 1];
+        pairs[0] = best;
+        ctx->bestMove = best.pair.first;
+        ctx->bestSecond = best.pair.second;
+        ctx->bestScore = alpha;
+        ctx->completedDepth = depth;
+        if (ctx->progress) {
+            ctx->progress->move.store(best.pair.first.row * BOARD_SIZE + best.pair.first.col);
+            ctx->progress->depth.store(depth);
+        }
+        ttStore(&tt, positionKey(&ctx->board, player) ^ zobristPairs, depth, TT_EXACT, alpha, best.pair.first);
+        
+        if (alpha >= WIN_SCORE - MAX_PLY || alpha <= -WIN_SCORE + MAX_PLY) break;
+        if (nowMs() >= ctx->softDeadline) break;
+    }
+}
+
+// ˫ӹroot棬bestMovesecondMoveΪһֵ
+template <int N>
+SearchResult Connect6<N>::searchPairs(const BoardState* root, ChessType player, const SearchLimits* limits) {
+    return runSearch(root, player, limits, true);
+}
+
+// Ĭ߳CPU
+int defaultSearchThreads() {
+    int cores = (int)std::thread::hardware_concurrency();
+    if (cores < 1) cores = 1;
+    return (cores > MAX_SEARCH_THREADS) ? MAX_SEARCH_THREADS : cores;
+}
+
+// playerĳ
+template <int N>
+int Connect6<N>::countWinCells(const PatternCache* pc, ChessType player) {
+    int c = player - CT_BLACK;
+    int count = 0;
+    for (int i = 0; i < BOARD_SIZE; i++) {
+        count += bitCount(pc->winCells[c][i]);
+    }
+    return count;
+}
+
+// (row, col)ӺĳܷճminStonesгĿռ
+template <int N>
+bool Connect6<N>::hasThreatShape(const BoardState* bs, ChessType player, int row, int col, int minStones) {
+    const LinePattern* cell = bs->patterns.cells[player - CT_BLACK][row][col];
+    for (int d = 0; d < 4; d++) {
+        if (cell[d].count >= minStones && cell[d].count + cell[d].empty >= WIN_COUNT) return true;
+    }
+    return false;
+}
+
+// ռplayer˫㣨Ӻϳ㣩ԼӺĳ
+// طҪģֻռ֮һ
+template <int N>
+int Connect6<N>::collectDoubleThreats(ThreatSearch* ts, ChessType player, Position* cells, int maxCells) {
+    BoardState* bs = &ts->board;
+    Position moves[MAX_MOVES];
+    int moveCount = collectCandidates(bs, moves);
+    int count = 0;
+    
+    for (int k = 0; k < moveCount; k++) {
+        Position m = moves[k];
+        if (!hasThreatShape(bs, player, m.row, m.col, WIN_COUNT - 1)) continue;
+        boardPlace(bs, m.row, m.col, player);
+        ts->nodes++;
+        if (countWinCells(&bs->patterns, player) >= 2) {
+            // ˫㱾ɵг㣬ȥغ
+            Position points[BOARD_SIZE * BOARD_SIZE + 1];
+            int pointCount = 0;
+            points[pointCount++] = m;
+            const LineBits* wins = bs->patterns.winCells[player - CT_BLACK];
+            for (int i = 0; i < BOARD_SIZE; i++) {
+                for (LineBits w = wins[i]; w; w &= w - 1) {
+                    points[pointCount].row = i;
+                    points[pointCount].col = lowestBit(w);
+                    pointCount++;
+                }
+            }
+            for (int p = 0; p < pointCount && count < maxCells; p++) {
+                bool seen = false;
+                for (int q = 0; q < count; q++) {
+                    if (cells[q].row == points[p].row && cells[q].col == points[p].col) seen = true;
+                }
+                if (!seen) cells[count++] = points[p];
+            }
+        }
+        boardRemove(bs, m.row, m.col);
+    }
+    return count;
+}
+
+
+// ڵԤǷ꣺ÿTHREAT_CLOCK_NODESڵ㿴һʱӺȡ־˽ֹʱ̻ȡͰԤ
+// յǰڵ֮ճԤ㷵أû֤Ķûҵ
+template <int N>
+bool Connect6<N>::threatExhausted(ThreatSearch* ts) {
+    if (ts->nodes >= ts->nextClockCheck) {
+        ts->nextClockCheck = ts->nodes + THREAT_CLOCK_NODES;
+        if (nowMs() >= ts->deadline || (ts->cancel != NULL && ts->cancel->load(std::memory_order_relaxed))) {
+            ts->budget = ts->nodes;
+        }
+    }
+    return ts->nodes >= ts->budget;
+}
+
+// ط壺ֻǻвŷӦԶʧܲɹ
+template <int N>
+bool Connect6<N>::threatDefend(ThreatSearch* ts, int ply) {
+    BoardState* bs = &ts->board;
+    ChessType attacker = ts->attacker;
+    ChessType defender = ts->defender;
+    
+    if (threatExhausted(ts) || ply >= ts->maxPly) return false;
+    
+    // طԼܳ
+    Position cell = {-1, -1};
+    if (findWinningCell(&bs->patterns, defender, &cell)) return false;
+    
+    // 壺ʤֻһ
+    int wins = countWinCells(&bs->patterns, attacker);
+    if (wins >= 2) return true;
+    if (wins == 1) {
+        findWinningCell(&bs->patterns, attacker, &cell);
+        boardPlace(bs, cell.row, cell.col, defender);
+        ts->nodes++;
+        bool result = threatAttack(ts, ply + 1, NULL);
+        boardRemove(bs, cell.row, cell.col);
+        return result;
+    }
+    if (!ts->allowFours) return false;
+    
+    // ģطռ˫㣬ҲԷ
+    Position replies[MAX_MOVES];
+    int replyCount = collectDoubleThreats(ts, attacker, replies, MAX_MOVES);
+    if (replyCount == 0) return false;
+    
+    Position moves[MAX_MOVES];
+    int moveCount = collectCandidates(bs, moves);
+    for (int k = 0; k < moveCount && replyCount < MAX_MOVES; k++) {
+        Position m = moves[k];
+        if (!hasThreatShape(bs, defender, m.row, m.col, WIN_COUNT - 1)) continue;
+        bool seen = false;
+        for (int q = 0; q < replyCount; q++) {
+            if (replies[q].row == m.row && replies[q].col == m.col) seen = true;
+        }
+        if (!seen) replies[replyCount++] = m;
+    }
+    
+    for (int k = 0; k < replyCount; k++) {
+        Position m = replies[k];
+        boardPlace(bs, m.row, m.col, defender);
+        ts->nodes++;
+        bool result = threatAttack(ts, ply + 1, NULL);
+        boardRemove(bs, m.row, m.col);
+        if (!result) return false;
+    }
+    return true;
+}
+
+// 壺ֻ߳壨ԼVCTʱĻģһŷɹ
+template <int N>
+bool Connect6<N>::threatAttack(ThreatSearch* ts, int ply, Position* firstMove) {
+    BoardState* bs = &ts->board;
+    ChessType attacker = ts->attacker;
+    ChessType defender = ts->defender;
+    
+    if (threatExhausted(ts) || ply >= ts->maxPly) return false;
+    
+    Position cell = {-1, -1};
+    if (findWinningCell(&bs->patterns, attacker, &cell)) {
+        if (firstMove) *firstMove = cell;
+        return true;
+    }
+    
+    // Էʱֻȶ£Ҫв
+    int defenderWins = countWinCells(&bs->patterns, defender);
+    if (defenderWins >= 2) return false;
+    
+    Position moves[MAX_MOVES];
+    int moveCount;
+    if (defenderWins == 1) {
+        findWinningCell(&bs->patterns, defender, &moves[0]);
+        moveCount = 1;
+    } else {
+        moveCount = collectCandidates(bs, moves);
+    }
+    
+    int minStones = ts->allowFours ? WIN_COUNT - 2 : WIN_COUNT - 1;
+    for (int k = 0; k < moveCount; k++) {
+        Position m = moves[k];
+        if (defenderWins == 0 && !hasThreatShape(bs, attacker, m.row, m.col, minStones)) continue;
+        boardPlace(bs, m.row, m.col, attacker);
+        ts->nodes++;
+        bool result = threatDefend(ts, ply + 1);
+        boardRemove(bs, m.row, m.col);
+        if (result) {
+            if (firstMove) *firstMove = m;
+            return true;
+        }
+        if (threatExhausted(ts)) return false;
+    }
+    return false;
+}
+
+// вռڽڵԤͽֹʱ̣룬LLONG_MAXʾʱ֤attackerвıʤ
+// allowFoursΪfalseʱֻѳ壨VCFͬʱʹûģVCT
+template <int N>
+bool Connect6<N>::solveThreats(const BoardState* root, ChessType attacker, bool allowFours,
+                  long long budget, long long deadline, const std::atomic<bool>* cancel, Position* move) {
+    STAT_TIMER(ET_THREATS);
+    ThreatSearch ts;
+    ts.board = *root;
+    ts.attacker = attacker;
+    ts.defender = (attacker == CT_BLACK) ? CT_WHITE : CT_BLACK;
+    ts.allowFours = allowFours;
+    ts.maxPly = allowFours ? VCT_MAX_PLY : VCF_MAX_PLY;
+    ts.nodes = 0;
+    ts.budget = budget;
+    ts.deadline = deadline;
+    ts.cancel = cancel;
+    ts.nextClockCheck = 0;
+    bool found = threatAttack(&ts, 0, move);
+    STAT_ADD(EC_THREAT_NODES, ts.nodes);
+    return found;
+}
+
+// ===== ˫ӹ˫вVCDT =====
+// ÿʱֻöԷһӾܶסвǿƣԷһԿ¡
+// ÿֶҪɱӲܶס˫вӲŶµסıʤ棩طֻڶ·ѡ
+// طӳķвʱչûҵҵĶȷıʤ
+
+// attackerӳвҪӣ012Ӷ²סʱΪ3
+// 2ʱͬʱдblocksв·̫㲻ʱ-1
+template <int N>
+int Connect6<N>::pairBlockers(ThreatSearch* ts, ChessType attacker, StonePair* blocks, int* blockCount) {
+    BoardState* bs = &ts->board;
+    ChessType defender = (attacker == CT_BLACK) ? CT_WHITE : CT_BLACK;
+    Position cells[PAIR_THREAT_CELLS + 1];
+    Position rest;
+    *blockCount = 0;
+    int cellCount = collectPairThreats(bs, attacker, cells, PAIR_THREAT_CELLS + 1);
+    if (cellCount == 0) return 0;
+    if (cellCount > PAIR_THREAT_CELLS) return -1;
+    
+    // ֻвϣвӻⲻκһв
+    for (int a = 0; a < cellCount; a++) {
+        boardPlace(bs, cells[a].row, cells[a].col, defender);
+        ts->nodes++;
+        bool cleared = collectPairThreats(bs, attacker, &rest, 1) == 0;
+        boardRemove(bs, cells[a].row, cells[a].col);
+        if (cleared) return 1;
+    }
+    for (int a = 0; a < cellCount; a++) {
+        boardPlace(bs, cells[a].row, cells[a].col, defender);
+        for (int b = a + 1; b < cellCount; b++) {
+            boardPlace(bs, cells[b].row, cells[b].col, defender);
+            ts->nodes++;
+            bool cleared = collectPairThreats(bs, attacker, &rest, 1) == 0;
+            boardRemove(bs, cells[b].row, cells[b].col);
+            if (!cleared) continue;
+            if (*blockCount == PAIR_THREAT_BLOCKS) {
+                boardRemove(bs, cells[a].row, cells[a].col);
+                return -1;
+            }
+            blocks[*blockCount].first = cells[a];
+            blocks[*blockCount].second = cells[b];
+            (*blockCount)++;
+        }
+        boardRemove(bs, cells[a].row, cells[a].col);
+    }
+    return (*blockCount > 0) ? 2 : 3;
+}
+
+// ط壺ԼܳʧܣֻӲŶµסʱһÿֶ·ȫʧܲɹ
+template <int N>
+bool Connect6<N>::pairThreatDefend(ThreatSearch* ts, int ply) {
+    BoardState* bs = &ts->board;
+    if (threatExhausted(ts) || ply >= ts->maxPly) return false;
+    
+    StonePair pair;
+    if (findPairWin(bs, ts->defender, &pair)) return false;
+    
+    StonePair blocks[PAIR_THREAT_BLOCKS];
+    int blockCount;
+    int need = pairBlockers(ts, ts->attacker, blocks, &blockCount);
+    if (need == 3) return true;
+    if (need != 2) return false;
+    
+    for (int k = 0; k < blockCount; k++) {
+        placePair(bs, &blocks[k], ts->defender);
+        ts->nodes += 2;
+        bool result = pairThreatAttack(ts, ply + 1, NULL);
+        removePair(bs, &blocks[k]);
+        if (!result) return false;
+    }
+    return true;
+}
+
+// 壺һӵϣڶºߣһߣҪӣ
+// ɷطжǷ˫вһϳɹ
+template <int N>
+bool Connect6<N>::pairThreatAttack(ThreatSearch* ts, int ply, StonePair* firstPair) {
+    BoardState* bs = &ts->board;
+    ChessType attacker = ts->attacker;
+    if (threatExhausted(ts) || ply >= ts->maxPly) return false;
+    
+    StonePair pair;
+    if (findPairWin(bs, attacker, &pair)) {
+        if (firstPair) *firstPair = pair;
+        return true;
+    }
+    
+    // ԷӳвʱҪȷأﲻչ
+    Position threat;
+    if (collectPairThreats(bs, ts->defender, &threat, 1) > 0) return false;
+    
+    Position moves[MAX_MOVES];
+    int moveCount = collectCandidates(bs, moves);
+    LineBits tried[BOARD_SIZE] = {0};
+    for (int f = 0; f < moveCount; f++) {
+        pair.first = moves[f];
+        if (!hasThreatShape(bs, attacker, pair.first.row, pair.first.col, WIN_COUNT - 3)) continue;
+        tried[pair.first.row] |= 1u << pair.first.col;
+        boardPlace(bs, pair.first.row, pair.first.col, attacker);
+        ts->nodes++;
+        
+        Position seconds[MAX_MOVES];
+        int secondCount = collectCandidates(bs, seconds);
+        for (int s = 0; s < secondCount; s++) {
+            pair.second = seconds[s];
+            if (tried[pair.second.row] >> pair.second.col & 1) continue;
+            if (!hasThreatShape(bs, attacker, pair.second.row, pair.second.col, WIN_COUNT - 2)) continue;
+            boardPlace(bs, pair.second.row, pair.second.col, attacker);
+            ts->nodes++;
+            bool result = pairThreatDefend(ts, ply + 1);
+            boardRemove(bs, pair.second.row, pair.second.col);
+            if (result) {
+                boardRemove(bs, pair.first.row, pair.first.col);
+                if (firstPair) *firstPair = pair;
+                return true;
+            }
+            if (threatExhausted(ts)) break;
+        }
+        boardRemove(bs, pair.first.row, pair.first.col);
+        if (threatExhausted(ts)) return false;
+    }
+    return false;
+}
+
+// ˫вڽڵԤ㡢ֹʱ̺ȡ־֤attackerһбʤ
+template <int N>
+bool Connect6<N>::solvePairThreats(const BoardState* root, ChessType attacker,
+                  long long budget, long long deadline, const std::atomic<bool>* cancel, StonePair* pair) {
+    STAT_TIMER(ET_THREATS);
+    ThreatSearch ts;
+    ts.board = *root;
+    ts.attacker = attacker;
+    ts.defender = (attacker == CT_BLACK) ? CT_WHITE : CT_BLACK;
+    ts.allowFours = true;
+    ts.nodes = 0;
+    ts.budget = budget;
+    ts.deadline = deadline;
+    ts.cancel = cancel;
+    ts.nextClockCheck = 0;
+    
+    // 𲽼̵ıʤУһʱҲܺܿһ
+    bool found = false;
+    for (ts.maxPly = 2; ts.maxPly <= PAIR_THREAT_PLY && !found; ts.maxPly += 2) {
+        found = pairThreatAttack(&ts, 0, pair);
+        if (threatExhausted(&ts)) break;
+    }
+    STAT_ADD(EC_THREAT_NODES, ts.nodes);
+    return found;
+}
+
+// AIսжϣֱȷŷVCF/VCTдmovetrue
+// вռdeadline룬LLONG_MAXʾʱcancelλΪֹ㲻ĵûҵ
+template <int N>
+bool Connect6<N>::hardAITactics(const BoardState* bs, ChessType player, long long deadline,
+                                const std::atomic<bool>* cancel, Position* move) {
+    ChessType opponent = (player == CT_BLACK) ? CT_WHITE : CT_BLACK;
+    
+    // 1. ʤ
+    if (findWinningCell(&bs->patterns, player, move)) {
+        return true;
+    }
+    
+    // 2. ضԷʤ
+    if (findWinningCell(&bs->patterns, opponent, move)) {
+        return true;
+    }
+    
+    // 3. вռ壬в
+    return solveThreats(bs, player, false, THREAT_NODE_BUDGET, deadline, cancel, move) ||
+           solveThreats(bs, player, true, THREAT_NODE_BUDGET, deadline, cancel, move);
+}
+
+// AI˼ʱްвռڵ
+template <int N>
+Position Connect6<N>::hardAISearch(const BoardState* bs, ChessType player, const SearchLimits* limits) {
+    Position bestPos = {-1, -1};
+    long long deadline = (limits->timeLimitMs > 0) ? nowMs() + limits->timeLimitMs : LLONG_MAX;
+    if (hardAITactics(bs, player, deadline, limits->cancel, &bestPos)) {
+        return bestPos;
+    }
+    
+    // 4. ʣµʱʱѾҲٸ1루0ʾʱ
+    SearchLimits rest = *limits;
+    if (limits->timeLimitMs > 0) {
+        long long left = deadline - nowMs();
+        rest.timeLimitMs = (left < 1) ? 1 : (int)left;
+    }
+    return searchPosition(bs, player, &rest).bestMove;
+}
+
+// AI - Alpha-Betaֵ
+template <int N>
+Position Connect6<N>::hardAIMove(const BoardState* bs, ChessType player) {
+    SearchLimits limits = {searchTimeMs, searchMaxDepth, searchThreads, NULL, NULL, 0};
+    return hardAISearch(bs, player, &limits);
+}
+
+// AI˫ӹ򣩣ӶAIķʽѡ
+template <int N>
+StonePair Connect6<N>::easyAIPair(const BoardState* bs, ChessType player) {
+    StonePair pair;
+    BoardState next = *bs;
+    pair.first = easyAIMove(&next, player);
+    pair.second.row = -1;
+    pair.second.col = -1;
+    if (pair.first.row >= 0 && !boardCheckWin(&next, pair.first.row, pair.first.col, player, NULL)) {
+        boardPlace(&next, pair.first.row, pair.first.col, player);
+        pair.second = easyAIMove(&next, player);
+    }
+    return pair;
+}
+
+// еAI˫ӹ򣩣ܳͳȡʽߵ
+template <int N>
+StonePair Connect6<N>::mediumAIPair(const BoardState* bs, ChessType player) {
+    StonePair pair;
+    BoardState next = *bs;
+    if (findPairWin(&next, player, &pair)) {
+        return pair;
+    }
+    ScoredPair best;
+    if (generatePairs(&next, player, &best, 1) == 0) {
+        return easyAIPair(bs, player);
+    }
+    return best.pair;
+}
+
+// AI˫ӹ򣩵սжϣֱȷһ֣ΨһӶ·˫вдpairtrue
+// ˫вdeadlinecancelλΪֹ㲻ĵûҵ
+template <int N>
+bool Connect6<N>::hardAIPairTactics(const BoardState* bs, ChessType player, long long deadline,
+                                    const std::atomic<bool>* cancel, StonePair* pair) {
+    ChessType opponent = (player == CT_BLACK) ? CT_WHITE : CT_BLACK;
+    ThreatSearch ts;
+    ts.board = *bs;
+    ts.nodes = 0;
+    
+    // 1. һֱӳ
+    if (findPairWin(&ts.board, player, pair)) {
+        return true;
+    }
+    
+    // 2. ԷвӶ¡ֻһֶ·бĶ·һӾ͹ʱ
+    StonePair blocks[PAIR_THREAT_BLOCKS];
+    int blockCount;
+    int need = pairBlockers(&ts, opponent, blocks, &blockCount);
+    if (need == 2 && blockCount == 1) {
+        *pair = blocks[0];
+        return true;
+    }
+    if (need != 0) return false;
+    
+    // 3. ˫в
+    return solvePairThreats(bs, player, THREAT_NODE_BUDGET, deadline, cancel, pair);
+}
+
+// AI˫ӹ򣩰˼ʱް˫вڵ֣
+// ˫вûҵʱԤ㣬ֻһʱ
+template <int N>
+StonePair Connect6<N>::hardAIPairSearch(const BoardState* bs, ChessType player, const SearchLimits* limits) {
+    StonePair pair;
+    long long start = nowMs();
+    long long deadline = (limits->timeLimitMs > 0) ? start + limits->timeLimitMs : LLONG_MAX;
+    long long tacticsDeadline = (limits->timeLimitMs > 0) ? start + limits->timeLimitMs / PAIR_THREAT_SHARE : LLONG_MAX;
+    if (hardAIPairTactics(bs, player, tacticsDeadline, limits->cancel, &pair)) {
+        return pair;
+    }
+    
+    SearchLimits rest = *limits;
+    if (limits->timeLimitMs > 0) {
+        long long left = deadline - nowMs();
+        rest.timeLimitMs = (left < 1) ? 1 : (int)left;
+    }
+    SearchResult result = searchPairs(bs, player, &rest);
+    if (result.bestMove.row < 0) {
+        return mediumAIPair(bs, player);
+    }
+    pair.first = result.bestMove;
+    pair.second = result.secondMove;
+    return pair;
+}
+
+// AI˫ӹ򣩣ʹȫֵ
+template <int N>
+StonePair Connect6<N>::hardAIPair(const BoardState* bs, ChessType player) {
+    SearchLimits limits = {searchTimeMs, searchMaxDepth, searchThreads, NULL, NULL, 0};
+    return hardAIPairSearch(bs, player, &limits);
+}
+
+// ===== ģ =====
+// Ӹ˫пλоӣֱһλбɾ
+// ֻ龭ӵߣÿһλ㣬ÿһӵĿϵ޹
+
+// λ̲гпλ
+template <int N>
+void Connect6<N>::playoutInit(PlayoutBoard* pb, const BitBoard* bb) {
+    pb->bits = *bb;
+    pb->emptyCount = 0;
+    for (int row = 0; row < BOARD_SIZE; row++) {
+        for (LineBits empty = emptyBits(bb, row); empty; empty &= empty - 1) {
+            pb->empty[pb->emptyCount++] = (unsigned short)(row * BOARD_SIZE + lowestBit(empty));
+        }
+    }
+}
+
+// pbһ֣stonesΪpbϵһÿһӵӷ
+// ʤ巵CT_EMPTYlengthΪNULLʱһģµ
+template <int N>
+ChessType Connect6<N>::randomPlayout(PlayoutBoard* pb, RuleMode rule, int stones, Rng* rng, int* length) {
+    // λ״̬ھֲλ̵дintpbÿһӶҪ¶
+    Rng state = *rng;
+    int emptyCount = pb->emptyCount;
+    ChessType winner = CT_EMPTY;
+    int placed = 0;
+    while (emptyCount > 0) {
+        ChessType player = stoneOwner(rule, stones + placed);
+        int index = (int)rngBounded(&state, emptyCount);
+        int cell = pb->empty[index];
+        pb->empty[index] = pb->empty[--emptyCount];
+        int row = cell / BOARD_SIZE;
+        int col = cell % BOARD_SIZE;
+        int c = player - CT_BLACK;
+        bitboardSet(&pb->bits, row, col, player);
+        placed++;
+        // ÿȡΪĵ11жϵļһģҪϰٴ
+        if (shapeTables.six[((pb->bits.rows[c][row] << SHAPE_SIDE) >> col) & 0x7FF] |
+            shapeTables.six[((pb->bits.cols[c][col] << SHAPE_SIDE) >> row) & 0x7FF] |
+            shapeTables.six[((pb->bits.diags[c][row - col + BOARD_SIZE - 1] << SHAPE_SIDE) >> col) & 0x7FF] |
+            shapeTables.six[((pb->bits.antiDiags[c][row + col] << SHAPE_SIDE) >> col) & 0x7FF]) {
+            winner = player;
+            break;
+        }
+    }
+    pb->emptyCount = emptyCount;
+    *rng = state;
+    if (length != NULL) {
+        *length = placed;
+    }
+    return winner;
+}
+
+// ===== ؿ =====
+// ÿģӸUCTѡҶڵ㣬ҶڵڶαʱչٴҶڵһֲش
+// ̹߳һĽڵȼʧ߳ʱܿͬһ·شʱٻʵ
+// ÿһһӣɹӷ˫ӹһֵӾ
+
+// ϵ
+template <int N>
+int Connect6<N>::countStones(const BitBoard* bb) {
+    int stones = 0;
+    for (int row = 0; row < BOARD_SIZE; row++) {
+        stones += bitCount(bb->rows[0][row] | bb->rows[1][row]);
+    }
+    return stones;
+}
+
+// չڵ㣺ܳʱֻгһӽڵ㣻ȡŷɵǰMCTS_BRANCHѡ㣨Էгʱֻжµ㣩
+// ͷִӸߵУûʹӽڵ㰴˳ȱԡڵûпߵĵʱfalseڵΪMCTS_NO_EXPANDֱ֮Ӵģ
+template <int N>
+bool Connect6<N>::mctsExpand(MctsTree* tree, MctsNode* node, const BoardState* bs, ChessType player) {
+    // ڵطŲһӽڵʱŷ
+    if (tree->used.load(std::memory_order_relaxed) + MCTS_BRANCH > tree->capacity) {
+        node->firstChild.store(MCTS_NO_EXPAND, std::memory_order_release);
+        return false;
+    }
+    
+    ScoredMove moves[MCTS_BRANCH];
+    int count;
+    bool terminal = findWinningCell(&bs->patterns, player, &moves[0].pos);
+    if (terminal) {
+        count = 1;
+    } else {
+        count = generateMoves(bs, player, moves, MCTS_BRANCH);
+        if (count == 0 && countStones(&bs->bits) == 0) {
+            moves[0].pos.row = BOARD_SIZE / 2;
+            moves[0].pos.col = BOARD_SIZE / 2;
+            count = 1;
+        }
+    }
+    if (count == 0) {
+        node->firstChild.store(MCTS_NO_EXPAND, std::memory_order_release);
+        return false;
+    }
+    int first = tree->used.fetch_add(count);
+    if (first + count > tree->capacity) {
+        node->firstChild.store(MCTS_NO_EXPAND, std::memory_order_release);
+        return false;
+    }
+    
+    for (int i = 0; i < count; i++) {
+        MctsNode* child = &tree->nodes[first + i];
+        child->visits.store(0, std::memory_order_relaxed);
+        child->score.store(0, std::memory_order_relaxed);
+        child->firstChild.store(MCTS_LEAF, std::memory_order_relaxed);
+        child->childCount = 0;
+        child->move = moves[i].pos;
+        child->terminal = terminal;
+    }
+    STAT_ADD(EC_NODES, count);
+    node->childCount = count;
+    node->firstChild.store(first, std::memory_order_release);
+    return true;
+}
+
+// UCTѡûʹӽڵȣȡƽ÷ּ̽
+template <int N>
+int Connect6<N>::mctsSelect(const MctsTree* tree, const MctsNode* node) {
+    int first = node->firstChild.load(std::memory_order_acquire);
+    int parentVisits = node->visits.load(std::memory_order_relaxed);
+    float logParent = logf((float)(parentVisits > 1 ? parentVisits : 1));
+    int best = first;
+    float bestValue = -1.0f;
+    for (int i = first; i < first + node->childCount; i++) {
+        const MctsNode* child = &tree->nodes[i];
+        int visits = child->visits.load(std::memory_order_relaxed);
+        if (visits == 0) return i;
+        float mean = child->score.load(std::memory_order_relaxed) / (2.0f * visits);
+        float value = mean + MCTS_EXPLORATION * sqrtf(logParent / visits);
+        if (value > bestValue) {
+            bestValue = value;
+            best = i;
+        }
+    }
+    return best;
+}
+
+// ʴӽڵ㣬ûӽڵʱ-1
+template <int N>
+int Connect6<N>::mctsBestChild(const MctsTree* tree, const MctsNode* node) {
+    int first = node->firstChild.load(std::memory_order_acquire);
+    if (first < 0) return -1;
+    int best = first;
+    for (int i = first + 1; i < first + node->childCount; i++) {
+        if (tree->nodes[i].visits.load(std::memory_order_relaxed) > tree->nodes[best].visits.load(std::memory_order_relaxed)) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+// bsһ֣stonesΪbsϵʤ巵CT_EMPTY
+// ģ⽻randomPlayoutпλоѡʽģȳٶ鼸ѡȡͷߵ
+template <int N>
+ChessType Connect6<N>::mctsPlayout(BoardState* bs, RuleMode rule, int stones, Rng* rng, bool biased) {
+    if (!biased) {
+        PlayoutBoard pb;
+        playoutInit(&pb, &bs->bits);
+        return randomPlayout(&pb, rule, stones, rng, NULL);
+    }
+    
+    Position moves[MAX_MOVES];
+    while (stones < MAX_MOVES) {
+        ChessType player = stoneOwner(rule, stones);
+        ChessType opponent = (player == CT_BLACK) ? CT_WHITE : CT_BLACK;
+        Position pos;
+        if (findWinningCell(&bs->patterns, player, &pos)) {
+            return player;
+        }
+        if (!findWinningCell(&bs->patterns, opponent, &pos)) {
+            int count = collectCandidates(bs, moves);
+            if (count == 0) return CT_EMPTY;
+            pos = moves[rngBounded(rng, count)];
+            int bestScore = cellScore(bs, pos.row, pos.col, player);
+            for (int k = 1; k < MCTS_BIAS_SAMPLES; k++) {
+                Position other = moves[rngBounded(rng, count)];
+                int score = cellScore(bs, other.row, other.col, player);
+                if (score > bestScore) {
+                    bestScore = score;
+                    pos = other;
+                }
+            }
+        }
+        boardPlace(bs, pos.row, pos.col, player);
+        stones++;
+    }
+    return CT_EMPTY;
+}
+
+// һ̣߳ѡչģ⡢شֱʱģ
+template <int N>
+void Connect6<N>::mctsWorker(MctsTree* tree, int threadIndex) {
+    Rng rng;
+    rngSeed(&rng, tree->seed, (unsigned long long)threadIndex);
+    int path[MAX_MOVES + 1];
+    BoardState* bs = new BoardState;
+    
+    for (long long iteration = 0; !tree->stop.load(std::memory_order_relaxed); iteration++) {
+        if ((iteration & 31) == 0 &&
+            (nowMs() >= tree->deadline || (tree->cancel && tree->cancel->load(std::memory_order_relaxed)))) {
+            tree->stop.store(true);
+            break;
+        }
+        if (tree->playoutLimit > 0 && tree->playouts.fetch_add(1, std::memory_order_relaxed) >= tree->playoutLimit) {
+            tree->stop.store(true);
+            break;
+        }
+        
+        // ѡ;ʧ
+        *bs = tree->root;
+        int stones = tree->rootStones;
+        int length = 0;
+        MctsNode* node = &tree->nodes[0];
+        node->visits.fetch_add(MCTS_VIRTUAL_LOSS, std::memory_order_relaxed);
+        path[length++] = 0;
+        ChessType winner = CT_EMPTY;
+        bool decided = false;
+        while (true) {
+            if (node->terminal) {
+                winner = stoneOwner(tree->rule, stones - 1);
+                decided = true;
+                break;
+            }
+            int first = node->firstChild.load(std::memory_order_acquire);
+            if (first < 0) {
+                // Ҷڵ㣺ٱʹһβչչȨ߳չѡ
+                int expected = MCTS_LEAF;
+                if (first != MCTS_LEAF || node->visits.load(std::memory_order_relaxed) <= MCTS_VIRTUAL_LOSS ||
+                    !node->firstChild.compare_exchange_strong(expected, MCTS_EXPANDING) ||
+                    !mctsExpand(tree, node, bs, stoneOwner(tree->rule, stones))) {
+                    break;
+                }
+            }
+            int index = mctsSelect(tree, node);
+            node = &tree->nodes[index];
+            node->visits.fetch_add(MCTS_VIRTUAL_LOSS, std::memory_order_relaxed);
+            path[length++] = index;
+            boardPlace(bs, node->move.row, node->move.col, stoneOwner(tree->rule, stones));
+            stones++;
+        }
+        
+        // ģ
+        if (!decided) {
+            winner = mctsPlayout(bs, tree->rule, stones, &rng, tree->biased);
+        }
+        STAT_ADD(EC_PLAYOUTS, 1);
+        
+        // شʧʵkǸ֮ĵk
+        for (int k = 0; k < length; k++) {
+            MctsNode* visited = &tree->nodes[path[k]];
+            visited->visits.fetch_add(1 - MCTS_VIRTUAL_LOSS, std::memory_order_relaxed);
+            if (k > 0) {
+                ChessType owner = stoneOwner(tree->rule, tree->rootStones + k - 1);
+                int score = (winner == owner) ? 2 : (winner == CT_EMPTY) ? 1 : 0;
+                visited->score.fetch_add(score, std::memory_order_relaxed);
+            }
+        }
+        
+        // ̶߳ڱŷҪĳ
+        if (threadIndex == 0 && tree->progress && (iteration & 255) == 255) {
+            int best = mctsBestChild(tree, &tree->nodes[0]);
+            int depth = 0;
+            for (int i = best; i >= 0; i = mctsBestChild(tree, &tree->nodes[i])) depth++;
+            if (best >= 0) {
+                tree->progress->move.store(tree->nodes[best].move.row * BOARD_SIZE + tree->nodes[best].move.col);
+                tree->progress->depth.store(depth);
+            }
+        }
+    }
+    delete bs;
+}
+
+// ̣߳ͳƴ㿪ʼۼƣʱ̺߳ϲ
+template <int N>
+void Connect6<N>::mctsThread(MctsTree* tree, int threadIndex, EngineStats* stats) {
+    memset(&engineStats, 0, sizeof(engineStats));
+    mctsWorker(tree, threadIndex);
+    *stats = engineStats;
+}
+
+// ȡһڵأȸÿеģmctsPoolNodesͬͷţûʱ·䣬ڴ治㷵NULL
+template <int N>
+typename Connect6<N>::MctsPool* Connect6<N>::mctsAcquirePool() {
+    MctsPool* pool;
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> guard(mctsPoolLock);
+            pool = mctsFreePools;
+            if (pool != NULL) mctsFreePools = pool->next;
+        }
+        if (pool == NULL || pool->capacity == mctsPoolNodes) break;
+        delete[] pool->nodes;
+        delete pool;
+    }
+    if (pool == NULL) {
+        pool = new (std::nothrow) MctsPool;
+        if (pool == NULL) return NULL;
+        pool->capacity = mctsPoolNodes;
+        pool->nodes = new (std::nothrow) MctsNode[pool->capacity];
+        if (pool->nodes == NULL) {
+            delete pool;
+            return NULL;
+        }
+    }
+    return pool;
+}
+
+// ѽڵطŻؿ
+template <int N>
+void Connect6<N>::mctsReturnPool(MctsPool* pool) {
+    std::lock_guard<std::mutex> guard(mctsPoolLock);
+    pool->next = mctsFreePools;
+    mctsFreePools = pool;
+}
+
+// ͷпеĽڵأ̴Сʱã
+template <int N>
+void Connect6<N>::mctsReleasePools() {
+    std::lock_guard<std::mutex> guard(mctsPoolLock);
+    while (mctsFreePools != NULL) {
+        MctsPool* pool = mctsFreePools;
+        mctsFreePools = pool->next;
+        delete[] pool->nodes;
+        delete pool;
+    }
+}
+
+// ؿֵplayerʱŷһplayerʱ˫ӹһ֣һصڶӣ
+// secondΪ{-1, -1}ڶڵһûչʱҲΪ{-1, -1}
+template <int N>
+StonePair Connect6<N>::mctsSearch(const BoardState* bs, ChessType player, RuleMode rule, const SearchLimits* limits) {
+    StonePair result = {{-1, -1}, {-1, -1}};
+    MctsTree* tree = new (std::nothrow) MctsTree;
+    MctsPool* pool = mctsAcquirePool();
+    if (tree == NULL || pool == NULL) {
+        delete tree;
+        if (pool != NULL) mctsReturnPool(pool);
+        result.first = mediumAIMove(bs, player);
+        return result;
+    }
+    
+    long long start = nowMs();
+    MctsNode* nodes = pool->nodes;
+    tree->nodes = nodes;
+    tree->capacity = pool->capacity;
+    tree->used.store(1);
+    tree->root = *bs;
+    tree->rootStones = countStones(&bs->bits);
+    tree->rule = rule;
+    tree->biased = mctsBiased;
+    tree->playouts.store(0);
+    tree->playoutLimit = limits->playouts;
+    tree->deadline = (limits->timeLimitMs > 0) ? start + limits->timeLimitMs : LLONG_MAX;
+    if (tree->playoutLimit <= 0 && limits->timeLimitMs <= 0) tree->playoutLimit = MCTS_PLAYOUTS;
+    tree->stop.store(false);
+    tree->cancel = limits->cancel;
+    tree->progress = limits->progress;
+    tree->seed = (unsigned long long)nowNs();
+    
+    // ڵɵ÷ʵӷչӷplayerһʱplayerΪ׼
+    MctsNode* root = &nodes[0];
+    root->visits.store(0);
+    root->score.store(0);
+    root->firstChild.store(MCTS_EXPANDING);
+    root->childCount = 0;
+    root->move.row = -1;
+    root->move.col = -1;
+    root->terminal = false;
+    if (stoneOwner(rule, tree->rootStones) != player) {
+        tree->rootStones++;
+    }
+    if (mctsExpand(tree, root, bs, player)) {
+        // ֻһѡ񣨳ΨһĶµ㣩ʱģ
+        if (root->childCount > 1 || stonesToPlay(rule, tree->rootStones) == 2) {
+            int threadCount = limits->threads;
+            if (threadCount < 1) threadCount = 1;
+            if (threadCount > MAX_SEARCH_THREADS) threadCount = MAX_SEARCH_THREADS;
+            std::thread* helpers = new std::thread[threadCount];
+            EngineStats* helperStats = new EngineStats[threadCount];
+            for (int i = 1; i < threadCount; i++) {
+                helpers[i] = std::thread(mctsThread, tree, i, &helperStats[i]);
+            }
+            mctsWorker(tree, 0);
+            tree->stop.store(true);
+            for (int i = 1; i < threadCount; i++) {
+                helpers[i].join();
+#if ENGINE_STATS
+                statsMerge(&engineStats, &helperStats[i]);
+#endif
+            }
+            delete[] helperStats;
+            delete[] helpers;
+        }
+        
+        int best = mctsBestChild(tree, root);
+        result.first = nodes[best].move;
+        if (!nodes[best].terminal && stoneOwner(rule, tree->rootStones + 1) == player) {
+            int second = mctsBestChild(tree, &nodes[best]);
+            if (second >= 0) result.second = nodes[second].move;
+        }
+#if ENGINE_STATS
+        int depth = 0;
+        for (int i = best; i >= 0; i = mctsBestChild(tree, &nodes[i])) depth++;
+        engineStats.depth = depth;
+#endif
+    }
+    STAT_ADD(EC_SEARCHES, 1);
+    
+    mctsReturnPool(pool);
+    delete tree;
+    return result;
+}
+
+// ؿAIʹȫֵʱ䡢ģ߳
+template <int N>
+Position Connect6<N>::mctsAIMove(const BoardState* bs, ChessType player) {
+    SearchLimits limits = {searchTimeMs, searchMaxDepth, searchThreads, NULL, NULL, mctsPlayouts};
+    return mctsSearch(bs, player, ruleMode, &limits).first;
+}
+
+// ؿAI˫ӹ򣩣ʹȫֵʱ䡢ģ߳
+template <int N>
+StonePair Connect6<N>::mctsAIPair(const BoardState* bs, ChessType player) {
+    SearchLimits limits = {searchTimeMs, searchMaxDepth, searchThreads, NULL, NULL, mctsPlayouts};
+    return mctsAIPairSearch(bs, player, &limits);
+}
+
+// ؿAI˫ӹָƣڶڵһûչʱеAI
+template <int N>
+StonePair Connect6<N>::mctsAIPairSearch(const BoardState* bs, ChessType player, const SearchLimits* limits) {
+    StonePair pair = mctsSearch(bs, player, RULE_CONNECT6, limits);
+    if (pair.first.row >= 0 && pair.second.row < 0 &&
+        !boardCheckWin(bs, pair.first.row, pair.first.col, player, NULL)) {
+        BoardState next = *bs;
+        boardPlace(&next, pair.first.row, pair.first.col, player);
+        pair.second = mediumAIMove(&next, player);
+    }
+    return pair;
+}
+
+// ̨˼̣߳ȡܵļӦţΪÿһӦ
+// ÿֶֻһ㣬ۺʱӣԤⶼȵĽͬʱû
+template <int N>
+void Connect6<N>::ponderWorker(Ponder* p) {
+    ChessType opponent = (p->player == CT_BLACK) ? CT_WHITE : CT_BLACK;
+    ScoredMove replies[PONDER_REPLIES];
+    p->entryCount = generateMoves(&p->board, opponent, replies, PONDER_REPLIES);
+    for (int i = 0; i < p->entryCount; i++) {
+        PonderEntry* e = &p->entries[i];
+        BoardState next = p->board;
+        boardPlace(&next, replies[i].pos.row, replies[i].pos.col, opponent);
+        e->reply = replies[i].pos;
+        e->hash = next.hash;
+        e->answer.row = -1;
+        e->answer.col = -1;
+        e->depth = 0;
+        e->tactical = false;
+        // ⲽֱӻʤĲ㣻սŷȷģټҲܲȵ
+        if (boardCheckWin(&next, e->reply.row, e->reply.col, opponent, NULL)) {
+            e->depth = -1;
+        } else if (hardAITactics(&next, p->player, LLONG_MAX, &p->cancel, &e->answer)) {
+            e->depth = searchMaxDepth;
+            e->tactical = true;
+        }
+        if (p->cancel.load()) return;
+    }
+    
+    for (int depth = 2; depth <= searchMaxDepth; depth++) {
+        for (int i = 0; i < p->entryCount; i++) {
+            PonderEntry* e = &p->entries[i];
+            if (e->depth < 0 || e->depth >= depth) continue;
+            
+            BoardState next = p->board;
+            boardPlace(&next, e->reply.row, e->reply.col, opponent);
+            SearchLimits limits = {0, depth, searchThreads, &p->cancel, NULL, 0};
+            SearchResult result = searchPosition(&next, p->player, &limits);
+            if (p->cancel.load()) return;
+            e->answer = result.bestMove;
+            e->depth = result.depth;
+        }
+    }
+}
+
+// ڶ˼ڼ俪ʼΪplayer̨˼bsΪǰֵߵľ
+template <int N>
+void Connect6<N>::ponderStart(const BoardState* bs, ChessType player) {
+    ponderStop();
+    ponder.board = *bs;
+    ponder.player = player;
+    ponder.entryCount = 0;
+    ponder.cancel.store(false);
+    ponder.worker = std::thread(ponderWorker, &ponder);
+    ponder.running = true;
+}
+
+// ֹ̨ͣ˼ȴ߳˳ÿ1024ڵһΣܷܿأ
+template <int N>
+void Connect6<N>::ponderStop() {
+    if (!ponder.running) return;
+    ponder.cancel.store(true);
+    ponder.worker.join();
+    ponder.running = false;
+}
+
+// ѾӡϣΪhashʱҺ̨˼õĻӦ
+// ֻԤ㵽㹻ȣӦսжϵóŷtrue÷ճûĽԿɸã
+template <int N>
+bool Connect6<N>::ponderLookup(unsigned long long hash, Position* answer) {
+    for (int i = 0; i < ponder.entryCount; i++) {
+        const PonderEntry* e = &ponder.entries[i];
+        if (e->hash == hash && (e->tactical || e->depth >= PONDER_ACCEPT_DEPTH) && e->answer.row != -1) {
+            *answer = e->answer;
+            return true;
+        }
+    }
+    return false;
+}
+
+// ʱΪAIһʱ䣨룩
+// ʱģʽ°ʣʱƽ̯һԤƻʣļϣƣ˫ӹһһ֣
+// ԤƾֳMOVES_TO_GOƽ̯ʣʱ𲽵ݼ
+// ÿMIN_MOVE_TIME_MSʣʱ䣬ʱʱҲٸ1루0ʾʱ
+template <int N>
+int Connect6<N>::allocateMoveTime(const TimeControl* tc, long long clockMs, RuleMode rule, int stonesPlayed) {
+    if (tc->type == TC_PER_MOVE) {
+        return tc->moveTimeMs;
+    }
+    
+    int turnsPlayed = (rule == RULE_CONNECT6) ? (stonesPlayed + 1) / 2 : stonesPlayed;
+    long long movesToGo = EXPECTED_TURNS - turnsPlayed / 2;
+    if (movesToGo < MOVES_TO_GO) movesToGo = MOVES_TO_GO;
+    long long budget = clockMs / movesToGo;
+    if (budget < MIN_MOVE_TIME_MS) budget = MIN_MOVE_TIME_MS;
+    if (budget > clockMs) budget = clockMs;
+    if (budget < 1) budget = 1;
+    return (int)budget;
+}
+
+// ʽʵ̴ֵ֧С
+template struct Connect6<15>;
+template struct Connect6<19>;
@@ -0,0 +1,616 @@
+// 棺̡ʷ͸AIκͼο
+// ͼν棨3.cppLinuxǰˣcli.cpp
+#ifndef ENGINE_H
+#define ENGINE_H
+
+#include <stddef.h>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#define WIN_COUNT 6        // ʤ
+#define MAX_BOARD_SIZE 19  // ֵ֧̣һеλͼ5䣩ŵý32λ
+#define SEARCH_MAX_DEPTH 8         // AI
+#define SEARCH_TIME_MS 1000        // AIÿʱ䣨룩
+#define MAX_SEARCH_THREADS 64      // ߳
+#define SEARCH_BRANCH 12           // ÿڵչŷ
+#define MAX_PLY 32                 // 죩
+#define CANDIDATE_RANGE 2          // ѡӵ
+#define VCF_MAX_PLY 20             // 壨VCF
+#define VCT_MAX_PLY 12             // вVCT
+#define PAIR_THREAT_PLY 8          // ˫ӹ˫вVCDTÿһ
+#define PAIR_THREAT_CELLS 16       // Ӷ·ʱ࿼ǵвٶͲ
+#define PAIR_THREAT_BLOCKS 32      // ˫в࿼ǵӶ·ٶͲ
+#define PAIR_THREAT_SHARE 4        // ˫вÿʱ޵ļ֮һ
+#define THREAT_NODE_BUDGET 50000   // вռĽڵԤ
+#define THREAT_CLOCK_NODES 256     // вռÿôڵһνֹʱ̺ȡ־
+#define WIN_SCORE 1000000          // ʤķ
+#define TT_DEFAULT_MB 16           // ûĬռڴ棨MB
+#define SHAPE_SIDE 5               // ʹĸÿĸ11
+#define HALF_SHAPES 63             // һ5Ĺ淶̬һ赲֮ĸӲӰ
+#define SHAPE_COUNT (HALF_SHAPES * HALF_SHAPES)   // ͱ
+#define TT_BUCKET_SIZE 4           // ûÿͰıһͰռһУ
+#define EXPECTED_TURNS 20          // ʱģʽԤһм
+#define MOVES_TO_GO 8              // ʱģʽԤʣļ
+#define MIN_MOVE_TIME_MS 50        // ÿٷʱ䣨룩
+#define PONDER_REPLIES 6           // ̨˼ʱԤĶӦ
+#define PONDER_ACCEPT_DEPTH 6      // Ԥ㵽ʱֱӲã
+#define PAIR_FIRST 8               // ˫ӹÿֵһӵĺѡ
+#define PAIR_SECOND 4              // ÿһ֮ڶӵĺѡ
+#define PAIR_SHORTLIST 20          // ڶӴӵһӵǰôѡ㼰Χ´ѡ
+#define PAIR_BRANCH 16             // ˫ÿڵչ
+#define MCTS_POOL_NODES (1 << 20)  // ؿĬϵĽڵÿڵ28ֽڣ
+#define MCTS_MIN_POOL_NODES 4096   // ڴСڵʱٱĽڵ
+#define MCTS_PLAYOUTS 200000       // ؿAIÿĬϵģ
+#define MCTS_BRANCH 16             // ؿÿڵչĺѡ
+#define MCTS_EXPLORATION 1.0f      // UCT̽ϵ
+#define MCTS_VIRTUAL_LOSS 3        // ģ⾭ڵʱӵʧּƣ
+#define MCTS_BIAS_SAMPLES 3        // ʽģÿȡĺѡȡͷߵ
+#define MCTS_LEAF (-1)             // ڵδչ
+#define MCTS_EXPANDING (-2)        // ڵĳ߳չ
+#define MCTS_NO_EXPAND (-3)        // ڵûŷչֱӴģ
+#define PROFILE_BUCKETS 32         // ͳֱͼͰ0ͰΪ0kͰΪ[2^(k-1), 2^k)
+
+// ͳƵı뿪أʱ ENGINE_STATS=0 ȥAI·еļͼʱ
+#ifndef ENGINE_STATS
+#define ENGINE_STATS 1
+#endif
+
+// Ϸ״̬ö
+typedef enum {
+    GS_PLAYING,
+    GS_BLACK_WIN,
+    GS_WHITE_WIN,
+    GS_DRAW
+} GameStatus;
+
+// ö
+typedef enum {
+    CT_EMPTY,
+    CT_BLACK,
+    CT_WHITE
+} ChessType;
+
+// Ϸģʽö
+typedef enum {
+    GM_PVP,
+    GM_PVE_EASY,
+    GM_PVE_MEDIUM,
+    GM_PVE_HARD,
+    GM_PVE_MCTS        // ؿ
+} GameMode;
+
+// ӹ
+typedef enum {
+    RULE_ONE_STONE,    // ˫һ
+    RULE_CONNECT6      // ׼壺ڷһһӣ֮˫ÿ
+} RuleMode;
+
+// ṹ
+typedef struct {
+    int row;
+    int col;
+} Position;
+
+// ˫ӹµһ壬second.rowΪ-1ʾֻһӣһѾ
+typedef struct {
+    Position first;
+    Position second;
+} StonePair;
+
+// ϣ
+typedef struct {
+    StonePair pair;
+    int score;
+} ScoredPair;
+
+// һϵλͼkλӦϵk
+typedef unsigned int LineBits;
+
+// ĳһڿλӺ󣬸øһϵͳƣڵĸֻrunstart
+typedef struct {
+    unsigned char count;   // ֱԷӻ߽Ϊֹļø񣩣Ϊ0
+    unsigned char empty;   // ͬһΧڵĿλø
+    unsigned char run;     // øø񣩣ԷΪ0
+    unsigned char start;   // ӵĵһڵλ
+} LinePattern;
+
+// ŷ
+typedef struct {
+    Position pos;
+    int score;
+} ScoredMove;
+
+// ȣ߳ÿһֵһΣ̶߳ȡ
+typedef struct {
+    std::atomic<int> depth;    // ɵ
+    std::atomic<int> move;     // ǰŷ row*̴С+col-1ʾû
+} SearchProgress;
+
+// 
+typedef struct {
+    int timeLimitMs;           // ʱƣ룩<=0ʾʱ
+    int maxDepth;              // 
+    int threads;               // ߳1ΪȷԵĵ߳
+    const std::atomic<bool>* cancel;   // ⲿȡ־ΪNULLλ췵
+    SearchProgress* progress;  // ΪNULL
+    long long playouts;        // ؿģޣ<=0ʾֻʱ
+} SearchLimits;
+
+// 
+typedef struct {
+    Position bestMove;         // ŷ˫ʱΪһӣ
+    Position secondMove;       // ˫ʱĵڶӣΪ{-1, -1}
+    int score;                 // ŷķ
+    int depth;                 // ɵ
+    long long nodes;           // ̵߳Ľڵ
+    long long timeMs;          // ʵʱ룩
+} SearchResult;
+
+// 
+typedef enum {
+    EC_NODES,          // Alpha-Betaڵ㣨̣߳
+    EC_THREAT_NODES,   // вռVCF/VCTӴ
+    EC_WIN_PROBES,     // ж
+    EC_MOVE_GEN,       // ŷ
+    EC_EVALS,          // ̬
+    EC_TT_PROBES,      // ûѯ
+    EC_TT_HITS,        // û
+    EC_TT_STORES,      // ûд
+    EC_SEARCHES,       // ؿ
+    EC_PLAYOUTS,       // ؿģԾ
+    EC_COUNT
+} EngineCounter;
+
+// ֶμʱǶ׵ĶθԼʱְвռ֮
+typedef enum {
+    ET_THREATS,        // вռ
+    ET_SEARCH,         // ̣߳
+    ET_SCORING,        // ѭŷɡ̬ˣ̺߳ϼƣ
+    ET_COUNT
+} EngineTimer;
+
+// һ߳ۼƵͳƣ߳̽ʱ뷢߳
+typedef struct {
+    long long counters[EC_COUNT];
+    unsigned long long ticks[ET_COUNT];   // ۼƵʱ
+    int depth;                 // һɵ
+} EngineStats;
+
+// һͳƣprofileBeginprofileEnd֮䱾߳ͳƵ
+typedef struct {
+    EngineStats delta;
+    EngineStats start;         // ʼʱĿ
+    int depth;                 // ɵȣûʱΪ0
+    long long startNs;
+    long long wallNs;          // ʵʱ룩
+    unsigned long long startTicks;
+    unsigned long long ticks;  // ͬһʱʱѸεʱ
+} MoveProfile;
+
+// һλỰжಽͳƵĻܣֱͼ2ݷͰ滮
+typedef struct {
+    long long moves;
+    long long totals[EC_COUNT];
+    long long timerNs[ET_COUNT];
+    long long wallNs;
+    long long timeHist[PROFILE_BUCKETS];   // ÿʱ΢룩
+    long long nodeHist[PROFILE_BUCKETS];   // ÿڵвռ
+    long long depthHist[MAX_PLY + 1];      // ÿɵ
+} ProfileSummary;
+
+// û߽
+typedef enum {
+    TT_NONE,
+    TT_EXACT,      // ȷֵ
+    TT_LOWER,      // ½磨betaضϣ
+    TT_UPPER       // Ͻ磨ûŷalpha
+} BoundType;
+
+// û key^data  dataʱУԣ̶߳д
+typedef struct {
+    std::atomic<unsigned long long> check;   // key ^ data
+    std::atomic<unsigned long long> data;    // ķŷȡ߽
+} TTEntry;
+
+typedef struct {
+    TTEntry entries[TT_BUCKET_SIZE];
+} TTBucket;
+
+// ̶СûͰΪ2
+typedef struct {
+    TTBucket* buckets;
+    size_t bucketCount;
+    std::atomic<unsigned int> age;   // ̭ɱֲʱ
+} TranspositionTable;
+
+// û
+typedef struct {
+    int score;
+    int depth;
+    BoundType bound;
+    Position move;
+} TTData;
+
+// ʱƷʽ
+typedef enum {
+    TC_PER_MOVE,       // ÿ̶ʱ
+    TC_TOTAL_CLOCK     // ʱޣÿʣʱ
+} TimeControlType;
+
+// ÿϷģʽAIʱ
+typedef struct {
+    TimeControlType type;
+    int moveTimeMs;            // ÿʱޣ룩TC_PER_MOVEʱʹ
+    int totalTimeMs;           // ʱޣ룩TC_TOTAL_CLOCKʱʹ
+    int minDisplayMs;          // չʾʱ䣺ñʱµĲ֣ӹͻأ
+} TimeControl;
+
+// PCG3264λ״̬ÿ32λÿ̸߳һݣģͼAIrand()
+typedef struct {
+    unsigned long long state;
+    unsigned long long inc;    // кţΪͬкŸص
+} Rng;
+
+// ȫ̴ֱС޹أ
+extern TranspositionTable tt;              // ûͬһʱֻһ̣ߴ繲ã
+extern int searchThreads;                  // AI߳
+extern int searchTimeMs;                   // AIÿʱ䣨룩<=0ʾʱ
+extern int searchMaxDepth;                 // AI
+extern long long mctsPlayouts;             // ؿAIÿģޣ<=0ʾֻʱ
+extern int mctsPoolNodes;                  // ؿĽڵ÷ɰڴ޵С
+extern bool mctsBiased;                    // ؿAIģⰴͷƫõ㣬ȫ
+extern RuleMode ruleMode;                  // ӹ
+extern thread_local EngineStats engineStats;   // ̵߳ͳ
+extern const char* const engineCounterNames[EC_COUNT];   // ͳе
+extern const char* const engineTimerNames[ET_COUNT];
+
+// ̴С޹صλ
+int lowestBit(LineBits bits);
+int bitCount(LineBits bits);
+LineBits sixInRowStarts(LineBits line);
+bool lineHasWinAt(LineBits line, int pos);
+int halfShape(unsigned int own, unsigned int blocked);
+unsigned long long splitMix64(unsigned long long* state);
+int defaultSearchThreads();
+int insertScored(ScoredMove* moves, int count, int maxMoves, Position pos, int score);
+
+// 
+void rngSeed(Rng* rng, unsigned long long seed, unsigned long long stream);
+unsigned int rngNext(Rng* rng);
+unsigned int rngBounded(Rng* rng, unsigned int bound);
+Rng* threadRng();
+
+// ӹ
+ChessType stoneOwner(RuleMode rule, int stoneIndex);
+int stonesToPlay(RuleMode rule, int stonesPlayed);
+
+// û
+bool ttResize(TranspositionTable* table, size_t megabytes);
+void ttRelease(TranspositionTable* table);
+void ttClear(TranspositionTable* table);
+void ttNewSearch(TranspositionTable* table);
+bool ttProbe(const TranspositionTable* table, unsigned long long key, TTData* out);
+void ttStore(TranspositionTable* table, unsigned long long key, int depth,
+             BoundType bound, int score, Position move);
+int scoreToTT(int score, int ply);
+int scoreFromTT(int score, int ply);
+
+// ʱ
+long long nowMs();
+long long nowUs();
+long long nowNs();
+unsigned long long statTicks();
+
+// ͳ
+void statsMerge(EngineStats* into, const EngineStats* from);
+void profileBegin(MoveProfile* p);
+void profileEnd(MoveProfile* p);
+long long profileTimerNs(const MoveProfile* p, EngineTimer timer);
+int profileFormat(const MoveProfile* p, char* buf, int size);
+int profileBucket(long long value);
+long long profilePercentile(const long long* hist, int buckets, double q);
+int histogramFormat(char* buf, int size, const char* name, const long long* hist, int buckets);
+void summaryReset(ProfileSummary* s);
+void summaryAdd(ProfileSummary* s, const MoveProfile* p);
+void summaryMerge(ProfileSummary* into, const ProfileSummary* from);
+int summaryFormat(const ProfileSummary* s, char* buf, int size);
+
+// ̴Сػ棺̡AI͸ֱԱڳĳߴʵ
+// ѭ߽Сǳȫչengine.cppĩβʽʵ15x1519x19֣
+// ʱѡһ֣ Connect6<19>::playMove(&game, 9, 9, CT_BLACK)
+template <int N>
+struct Connect6 {
+    static_assert(N >= WIN_COUNT && N <= MAX_BOARD_SIZE, "unsupported board size");
+    
+    static constexpr int BOARD_SIZE = N;                          // NxN
+    static constexpr int MAX_MOVES = N * N;                       // 
+    static constexpr int DIAG_COUNT = 2 * N - 1;                  // ÿĶԽ
+    static constexpr LineBits FULL_LINE = (1u << N) - 1;          // һеλ
+    static constexpr int CELL_COUNT = N * N;                      // iӦ(i / BOARD_SIZE, i % BOARD_SIZE)
+    static constexpr int CELL_STRIDE = (CELL_COUNT + 7) & ~7;     // 8ƽ鳤ȣ
+    static constexpr int CELL_WORDS = (CELL_STRIDE + 63) / 64;    // ƽλͼ64λ
+    
+    // λ̣ڰ˫԰ССԽߡԽͼ洢
+    // ±0Ϊڷ1Ϊ׷ԽͼкΪλ
+    typedef struct {
+        LineBits rows[2][BOARD_SIZE];        // ͼ: rows[c][row] ĵcolλ
+        LineBits cols[2][BOARD_SIZE];        // ͼ: cols[c][col] ĵrowλ
+        LineBits diags[2][DIAG_COUNT];       // Խ(K): ± row-col+BOARD_SIZE-1
+        LineBits antiDiags[2][DIAG_COUNT];   // Խ(L): ± row+col
+    } BitBoard;
+
+    // ͻ棺ÿӡÿɫĸͣmakeMoveά
+    typedef struct {
+        LinePattern cells[2][BOARD_SIZE][BOARD_SIZE][4];
+        unsigned short shapes[2][4][CELL_STRIDE];   // ԸøΪĵ11񴰿ڵͱ룬[ɫ][][]ƽ̣
+        LineBits winCells[2][BOARD_SIZE];    // ӼӵĿλд洢
+    } PatternCache;
+
+    // ѡ㼯ϣһӲ25x5ΧĿλ
+    typedef struct {
+        unsigned char nearStones[BOARD_SIZE][BOARD_SIZE];   // ÿΧ5x5Χڵ
+        LineBits cells[BOARD_SIZE];                         // ѡλд洢
+    } CandidateSet;
+
+    // 棺λ̼άĸֽṹ鸴Ƽɽʹ
+    typedef struct {
+        BitBoard bits;             // λ
+        PatternCache patterns;     // ͻ
+        CandidateSet candidates;   // ѡŷ
+        unsigned long long hash;   // Zobristϣ
+    } BoardState;
+
+    // һ״̬桢ʤʷͼν桢ЭģʽͷϵÿỰԳһݣӰ
+    typedef struct {
+        BoardState board;          // 
+        RuleMode rule;             // ӹ
+        GameStatus status;         // Ϸ״̬
+        ChessType currentPlayer;   // ǰ
+        Position lastMove;         // һλ
+        Position winLine[2];       // ֳʤʱɵһӵˣΪ{-1, -1}
+        int moveHistory[MAX_MOVES][2];   // ʷ¼
+        int moveCount;             // ǰ
+        int historyLength;         // ʷ¼ĳȣmoveCountĲֿ
+    } GameState;
+
+    // ̵߳ģ渱ʱͳ
+    typedef struct {
+        BoardState board;          // ߳˽еľ渱make/unmake޸
+        long long nodes;           // Ľڵ
+        long long deadline;        // ֹʱ̣룩ֹͣ
+        long long softDeadline;    // ֹʱ̣˾Ͳٿʼһֵ
+        bool stopped;              // ߳Ƿֹ
+        std::atomic<bool>* abort;  // ֹ̹߳־
+        const std::atomic<bool>* cancel;   // ÷ȡ־ΪNULL
+        SearchProgress* progress;  // ֻ߳ãΪNULL
+        int threadIndex;           // ̱߳ţ0Ϊ߳
+        int maxDepth;              // 
+        int completedDepth;        // һɵ
+        int bestScore;             // һķ
+        Position bestMove;         // һŷ
+        Position bestSecond;       // ˫ʱһֵĵڶ
+        EngineStats stats;         // ߳̽ʱͳƣɷ̺߳ϲ
+    } SearchContext;
+
+    // вռVCF/VCT״̬
+    typedef struct {
+        BoardState board;          // 渱
+        ChessType attacker;        // 
+        ChessType defender;        // ط
+        bool allowFours;           // ǷļвVCTֻó壨VCF
+        int maxPly;                // 
+        long long nodes;           // Ӵ
+        long long budget;          // ڵԤ
+        long long deadline;        // ֹʱ̣룩˾͵Ԥ
+        const std::atomic<bool>* cancel;   // ÷ȡ־ΪNULLλͬԤ
+        long long nextClockCheck;  // ´οʱӺȡ־ʱĽڵ
+    } ThreatSearch;
+
+    // ̨˼еһֵһֿӦżӦ
+    typedef struct {
+        Position reply;            // ԤĶӦ
+        unsigned long long hash;   // һľϣ
+        Position answer;           // Ӧ
+        int depth;                 // ɵȣ0ʾδ
+        bool tactical;             // Ӧսжϵóȷģмɲã޹
+    } PonderEntry;
+
+    // ̨˼˼ڼں̨߳ԤȼӦŵĻӦ
+    typedef struct {
+        BoardState board;          // ʼ˼ʱľ棨ֵߣ
+        ChessType player;          // Ϊһ˼
+        PonderEntry entries[PONDER_REPLIES];
+        int entryCount;
+        std::atomic<bool> cancel;  // ֹ̨֪ͨ߳ͣ
+        std::thread worker;
+        bool running;
+    } Ponder;
+
+    // ģọ̃λ̼ӿλбʱȡбеһĩλãɨ
+    typedef struct {
+        BitBoard bits;
+        unsigned short empty[CELL_COUNT];   // λĸӱţǰemptyCountЧ˳޹
+        int emptyCount;
+    } PlayoutBoard;
+
+    // ؿĽڵ㣬ͬһڵӽڵڽڵ
+    typedef struct {
+        std::atomic<int> visits;       // ʴڽеģ⸽ӵʧ
+        std::atomic<int> score;        // ģ֮ͣһӵһʤ2֡1֡0
+        std::atomic<int> firstChild;   // һӽڵ±꣬MCTS_LEAFʾδչMCTS_EXPANDINGʾչMCTS_NO_EXPANDʾչ
+        int childCount;
+        Position move;                 // ýڵµ
+        bool terminal;                 // һֱӳ
+    } MctsNode;
+
+    // ؿ̹߳һڵأ½ڵӳβɿ䣬ͷ
+    typedef struct {
+        MctsNode* nodes;
+        int capacity;
+        std::atomic<int> used;
+        BoardState root;               // 
+        int rootStones;                // һÿһһ
+        RuleMode rule;
+        bool biased;                   // ʽģ
+        std::atomic<long long> playouts;   // ѿʼģ
+        long long playoutLimit;
+        long long deadline;            // ֹʱ̣룩
+        std::atomic<bool> stop;
+        const std::atomic<bool>* cancel;
+        SearchProgress* progress;
+        unsigned long long seed;
+    } MctsTree;
+
+    // ڵأŻؿһֱӸãÿ·
+    typedef struct MctsPool {
+        MctsNode* nodes;
+        int capacity;
+        struct MctsPool* next;
+    } MctsPool;
+
+    // ȫ״̬ÿ̴СһݣжԾֹã
+    static unsigned long long zobristKeys[2][N][N];   // Zobrist
+    static unsigned long long zobristSide;     // ֵ׷ʱӵ
+    static unsigned long long zobristPairs;    // ˫ûӵ뵥
+    static Ponder ponder;                      // AIĺ̨˼ֻͼνʹã
+    static MctsPool* mctsFreePools;            // еؿڵأͬʱеȡһ
+    static std::mutex mctsPoolLock;            // mctsFreePools
+    
+    // λ
+    static void bitboardReset(BitBoard* bb);
+    static void bitboardSet(BitBoard* bb, int row, int col, ChessType type);
+    static void bitboardClear(BitBoard* bb, int row, int col);
+    static ChessType bitboardGet(const BitBoard* bb, int row, int col);
+    static LineBits emptyBits(const BitBoard* bb, int row);
+    static bool bitboardCheckWin(const BitBoard* bb, int row, int col, ChessType player);
+    static void lineLocate(int dir, int row, int col, int* line, int* pos);
+    static void lineCell(int dir, int line, int pos, int* row, int* col);
+    static void lineRange(int dir, int line, int* first, int* last);
+    static LineBits bitboardLine(const BitBoard* bb, int c, int dir, int line);
+    static void updateLineShapes(PatternCache* pc, const BitBoard* bb, int dir, int line, int first, int last);
+    static int shapeScore(const PatternCache* pc, int c, int row, int col, int dir);
+    static void refreshWinCell(PatternCache* pc, int c, int row, int col);
+    static void updateLinePatterns(PatternCache* pc, const BitBoard* bb, int dir, int line);
+    static void patternCacheRebuild(PatternCache* pc, const BitBoard* bb);
+    static void patternCacheUpdate(PatternCache* pc, const BitBoard* bb, int row, int col);
+    static bool findWinningCell(const PatternCache* pc, ChessType player, Position* pos);
+    static void initZobrist();
+    static void candidateAdd(CandidateSet* cs, const BitBoard* bb, int row, int col);
+    static void candidateRemove(CandidateSet* cs, int row, int col);
+    static int collectCandidates(const BoardState* bs, Position* moves);
+    static void boardReset(BoardState* bs);
+    static void boardPlace(BoardState* bs, int row, int col, ChessType player);
+    static void boardRemove(BoardState* bs, int row, int col);
+    static bool boardCheckWin(const BoardState* bs, int row, int col, ChessType player, Position* segment);
+    
+    // Ծ
+    static void resetGame(GameState* gs, RuleMode rule);
+    static bool playMove(GameState* gs, int row, int col, ChessType player);
+    static bool undoMove(GameState* gs);
+    static bool redoMove(GameState* gs);
+    static bool checkWin(const GameState* gs, int row, int col, ChessType player, Position* segment);
+    static bool isBoardFull(const GameState* gs);
+    
+    // 
+    static void candidateFlatBits(const CandidateSet* cs, unsigned long long flat[CELL_WORDS]);
+    static int weightedShapeScore(const PatternCache* pc, int c, int cell, int ownWeight, int oppWeight);
+    static void scoreCells(const BoardState* bs, ChessType player, int ownWeight, int oppWeight,
+                           const int* bonus, int* scores);
+    static int argmaxCells(const int* scores);
+    static int cellScore(const BoardState* bs, int row, int col, ChessType player);
+    static int evaluateBoard(const BoardState* bs, ChessType player);
+    
+    // AI
+    static Position easyAIMove(const BoardState* bs, ChessType player);
+    static Position mediumAIMove(const BoardState* bs, ChessType player);
+    static Position hardAIMove(const BoardState* bs, ChessType player);
+    static Position hardAISearch(const BoardState* bs, ChessType player, const SearchLimits* limits);
+    static StonePair easyAIPair(const BoardState* bs, ChessType player);
+    static StonePair mediumAIPair(const BoardState* bs, ChessType player);
+    static StonePair hardAIPair(const BoardState* bs, ChessType player);
+    static StonePair hardAIPairSearch(const BoardState* bs, ChessType player, const SearchLimits* limits);
+    static bool hardAITactics(const BoardState* bs, ChessType player, long long deadline,
+                              const std::atomic<bool>* cancel, Position* move);
+    static bool hardAIPairTactics(const BoardState* bs, ChessType player, long long deadline,
+                                  const std::atomic<bool>* cancel, StonePair* pair);
+    static Position mctsAIMove(const BoardState* bs, ChessType player);
+    static StonePair mctsAIPair(const BoardState* bs, ChessType player);
+    static StonePair mctsAIPairSearch(const BoardState* bs, ChessType player, const SearchLimits* limits);
+    static int allocateMoveTime(const TimeControl* tc, long long clockMs, RuleMode rule, int stonesPlayed);
+    
+    // 
+    static int generateMoves(const BoardState* bs, ChessType player, ScoredMove* moves, int maxMoves);
+    static unsigned long long positionKey(const BoardState* bs, ChessType player);
+    static int negamax(SearchContext* ctx, int depth, int alpha, int beta, ChessType player, int ply);
+    static void iterativeDeepening(SearchContext* ctx, ChessType player);
+    static void searchThread(SearchContext* ctx, ChessType player, bool pairs);
+    static SearchResult runSearch(const BoardState* root, ChessType player, const SearchLimits* limits, bool pairs);
+    static SearchResult searchPosition(const BoardState* root, ChessType player, const SearchLimits* limits);
+    
+    // ˫ӹŷ
+    static bool hasPairThreatWindow(const BoardState* bs, int c, int row, int col);
+    static int collectPairThreats(const BoardState* bs, ChessType player, Position* cells, int maxCells);
+    static bool findPairWin(BoardState* bs, ChessType player, StonePair* pair);
+    static int pickSecondStones(BoardState* bs, ChessType player, Position first, const ScoredMove* shortlist,
+                                int shortlistCount, ScoredMove* seconds);
+    static int generatePairs(BoardState* bs, ChessType player, ScoredPair* pairs, int maxPairs);
+    static void placePair(BoardState* bs, const StonePair* pair, ChessType player);
+    static void removePair(BoardState* bs, const StonePair* pair);
+    static int pairNegamax(SearchContext* ctx, int depth, int alpha, int beta, ChessType player, int ply);
+    static void pairIterativeDeepening(SearchContext* ctx, ChessType player);
+    static SearchResult searchPairs(const BoardState* root, ChessType player, const SearchLimits* limits);
+    
+    // вռ
+    static int countWinCells(const PatternCache* pc, ChessType player);
+    static bool hasThreatShape(const BoardState* bs, ChessType player, int row, int col, int minStones);
+    static int collectDoubleThreats(ThreatSearch* ts, ChessType player, Position* cells, int maxCells);
+    static bool threatExhausted(ThreatSearch* ts);
+    static bool threatDefend(ThreatSearch* ts, int ply);
+    static bool threatAttack(ThreatSearch* ts, int ply, Position* firstMove);
+    static bool solveThreats(const BoardState* root, ChessType attacker, bool allowFours,
+                             long long budget, long long deadline, const std::atomic<bool>* cancel, Position* move);
+    static int pairBlockers(ThreatSearch* ts, ChessType attacker, StonePair* blocks, int* blockCount);
+    static bool pairThreatDefend(ThreatSearch* ts, int ply);
+    static bool pairThreatAttack(ThreatSearch* ts, int ply, StonePair* firstPair);
+    static bool solvePairThreats(const BoardState* root, ChessType attacker,
+                                 long long budget, long long deadline, const std::atomic<bool>* cancel, StonePair* pair);
+    
+    // ģ
+    static void playoutInit(PlayoutBoard* pb, const BitBoard* bb);
+    static ChessType randomPlayout(PlayoutBoard* pb, RuleMode rule, int stones, Rng* rng, int* length);
+    
+    // ؿ
+    static int countStones(const BitBoard* bb);
+    static bool mctsExpand(MctsTree* tree, MctsNode* node, const BoardState* bs, ChessType player);
+    static int mctsSelect(const MctsTree* tree, const MctsNode* node);
+    static int mctsBestChild(const MctsTree* tree, const MctsNode* node);
+    static ChessType mctsPlayout(BoardState* bs, RuleMode rule, int stones, Rng* rng, bool biased);
+    static void mctsWorker(MctsTree* tree, int threadIndex);
+    static void mctsThread(MctsTree* tree, int threadIndex, EngineStats* stats);
+    static StonePair mctsSearch(const BoardState* bs, ChessType player, RuleMode rule, const SearchLimits* limits);
+    static MctsPool* mctsAcquirePool();
+    static void mctsReturnPool(MctsPool* pool);
+    static void mctsReleasePools();
+    
+    // ̨˼
+    static void ponderWorker(Ponder* p);
+    static void ponderStart(const BoardState* bs, ChessType player);
+    static void ponderStop();
+    static bool ponderLookup(unsigned long long hash, Position* answer);
+};
+
+// ڳĶ壨ʹʱҪ
+template <int N> constexpr int Connect6<N>::BOARD_SIZE;
+template <int N> constexpr int Connect6<N>::MAX_MOVES;
+template <int N> constexpr int Connect6<N>::DIAG_COUNT;
+template <int N> constexpr LineBits Connect6<N>::FULL_LINE;
+template <int N> constexpr int Connect6<N>::CELL_COUNT;
+template <int N> constexpr int Connect6<N>::CELL_STRIDE;
+template <int N> constexpr int Connect6<N>::CELL_WORDS;
+
+// engine.cppʵ̴С
+extern template struct Connect6<15>;
+extern template struct Connect6<19>;
+
+#endif
@@ -0,0 +1,223 @@
+// Ծּ¼дڴӳȡʽgamelog.h
+#include "gamelog.h"
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// ̴СӦÿŷֽ
+int gameLogCellBytes(int boardSize) {
+    return (boardSize * boardSize <= 256) ? 1 : 2;
+}
+
+// ־׼׷ӣļʱ
+bool gameLogOpen(GameLogWriter* log, const char* path) {
+    log->file = fopen(path, "ab");
+    log->games = 0;
+    return log->file != NULL;
+}
+
+void gameLogClose(GameLogWriter* log) {
+    if (log->file != NULL) {
+        fclose(log->file);
+        log->file = NULL;
+    }
+}
+
+// һֱһ¼bufGAMELOG_MAX_RECORDֽڣؼ¼ȣstatsΪNULL
+size_t gameLogEncode(unsigned char* buf, int boardSize, RuleMode rule, const int players[2], GameStatus result,
+                     const int moves[][2], int moveCount, const MoveStat* stats) {
+    int cellBytes = gameLogCellBytes(boardSize);
+    unsigned char* p = buf;
+    
+    *p++ = 'C';
+    *p++ = '6';
+    *p++ = GAMELOG_VERSION;
+    *p++ = (unsigned char)boardSize;
+    *p++ = (unsigned char)rule;
+    *p++ = (unsigned char)players[0];
+    *p++ = (unsigned char)players[1];
+    *p++ = (unsigned char)result;
+    *p++ = stats ? GAMELOG_HAS_STATS : 0;
+    *p++ = 0;
+    *p++ = (unsigned char)(moveCount & 0xFF);
+    *p++ = (unsigned char)(moveCount >> 8);
+    
+    for (int i = 0; i < moveCount; i++) {
+        int cell = moves[i][0] * boardSize + moves[i][1];
+        *p++ = (unsigned char)(cell & 0xFF);
+        if (cellBytes == 2) *p++ = (unsigned char)(cell >> 8);
+    }
+    
+    if (stats) {
+        for (int i = 0; i < moveCount; i++) {
+            int depth = stats[i].depth < 0 ? 0 : (stats[i].depth > 255 ? 255 : stats[i].depth);
+            int ms = stats[i].thinkMs < 0 ? 0 : (stats[i].thinkMs > 65535 ? 65535 : stats[i].thinkMs);
+            *p++ = (unsigned char)depth;
+            *p++ = (unsigned char)(ms & 0xFF);
+            *p++ = (unsigned char)(ms >> 8);
+        }
+    }
+    return p - buf;
+}
+
+// ׷һ֣ջϱ룬ټд
+bool gameLogAppend(GameLogWriter* log, int boardSize, RuleMode rule, const int players[2], GameStatus result,
+                   const int moves[][2], int moveCount, const MoveStat* stats) {
+    if (log->file == NULL || boardSize > MAX_BOARD_SIZE || moveCount < 0 || moveCount > boardSize * boardSize) {
+        return false;
+    }
+    // ȫΪ0ͳƣ˶ˡ˲AIдֻÿӵŷֽ
+    bool hasStats = false;
+    for (int i = 0; stats != NULL && i < moveCount && !hasStats; i++) {
+        hasStats = (stats[i].depth != 0 || stats[i].thinkMs != 0);
+    }
+    if (!hasStats) {
+        stats = NULL;
+    }
+    
+    unsigned char buf[GAMELOG_MAX_RECORD];
+    size_t length = gameLogEncode(buf, boardSize, rule, players, result, moves, moveCount, stats);
+    
+    std::lock_guard<std::mutex> guard(log->lock);
+    if (fwrite(buf, 1, length, log->file) != length) {
+        return false;
+    }
+    log->games++;
+    return true;
+}
+
+// ֻӳ־ļҲɹֻǶ¼
+bool gameLogMap(GameLogReader* reader, const char* path) {
+    reader->data = NULL;
+    reader->size = 0;
+    reader->offset = 0;
+#ifdef _WIN32
+    reader->file = NULL;
+    reader->mapping = NULL;
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        return false;
+    }
+    reader->file = file;
+    if (size.QuadPart == 0) {
+        return true;
+    }
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping == NULL) {
+        gameLogUnmap(reader);
+        return false;
+    }
+    reader->mapping = mapping;
+    reader->data = (const unsigned char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (reader->data == NULL) {
+        gameLogUnmap(reader);
+        return false;
+    }
+    reader->size = (size_t)size.QuadPart;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return false;
+    }
+    if (st.st_size > 0) {
+        void* data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            close(fd);
+            return false;
+        }
+        // ˳ͷβʾںԤ
+        madvise(data, (size_t)st.st_size, MADV_SEQUENTIAL);
+        reader->data = (const unsigned char*)data;
+        reader->size = (size_t)st.st_size;
+    }
+    close(fd);   // ӳ佨Ҫļ
+#endif
+    return true;
+}
+
+void gameLogUnmap(GameLogReader* reader) {
+#ifdef _WIN32
+    if (reader->data != NULL) UnmapViewOfFile(reader->data);
+    if (reader->mapping != NULL) CloseHandle((HANDLE)reader->mapping);
+    if (reader->file != NULL) CloseHandle((HANDLE)reader->file);
+    reader->mapping = NULL;
+    reader->file = NULL;
+#else
+    if (reader->data != NULL) munmap((void*)reader->data, reader->size);
+#endif
+    reader->data = NULL;
+    reader->size = 0;
+    reader->offset = 0;
+}
+
+// һ֣ĩβ𻵡дһļ¼ʱfalse
+bool gameLogNext(GameLogReader* reader, GameRecord* record) {
+    size_t left = reader->size - reader->offset;
+    if (left < GAMELOG_HEADER_SIZE) {
+        return false;
+    }
+    const unsigned char* p = reader->data + reader->offset;
+    if (p[0] != 'C' || p[1] != '6' || p[2] != GAMELOG_VERSION) {
+        return false;
+    }
+    
+    record->boardSize = p[3];
+    record->rule = (RuleMode)p[4];
+    record->players[0] = p[5];
+    record->players[1] = p[6];
+    record->result = (GameStatus)p[7];
+    record->moveCount = p[10] | (p[11] << 8);
+    record->cellBytes = gameLogCellBytes(record->boardSize);
+    if (record->boardSize < WIN_COUNT || record->boardSize > MAX_BOARD_SIZE ||
+        record->moveCount > record->boardSize * record->boardSize) {
+        return false;
+    }
+    
+    size_t movesBytes = (size_t)record->moveCount * record->cellBytes;
+    size_t statsBytes = (p[8] & GAMELOG_HAS_STATS) ? (size_t)record->moveCount * GAMELOG_STAT_SIZE : 0;
+    size_t length = GAMELOG_HEADER_SIZE + movesBytes + statsBytes;
+    if (length > left) {
+        return false;
+    }
+    record->moves = p + GAMELOG_HEADER_SIZE;
+    record->stats = statsBytes ? record->moves + movesBytes : NULL;
+    reader->offset += length;
+    return true;
+}
+
+// indexӵλ
+Position gameRecordMove(const GameRecord* record, int index) {
+    const unsigned char* m = record->moves + index * record->cellBytes;
+    int cell = (record->cellBytes == 2) ? (m[0] | (m[1] << 8)) : m[0];
+    Position pos = {cell / record->boardSize, cell % record->boardSize};
+    return pos;
+}
+
+// indexӵͳƣ¼ͳʱȫΪ0
+MoveStat gameRecordStat(const GameRecord* record, int index) {
+    MoveStat stat = {0, 0};
+    if (record->stats != NULL) {
+        const unsigned char* s = record->stats + index * GAMELOG_STAT_SIZE;
+        stat.depth = s[0];
+        stat.thinkMs = s[1] | (s[2] << 8);
+    }
+    return stat;
+}
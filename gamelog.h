@@ -0,0 +1,81 @@
+// Ծּ¼ֻ׷ӵĽն־Լڴӳ㿽ȡ
+// ÿһ¼ֱβӣûļͷ־catϲ
+//   ƫ 0  'C' '6'          ¼
+//        2  汾           GAMELOG_VERSION
+//        3  ̴С         1519
+//        4  ӹ         RuleMode
+//        5  ִڷ           0Ϊˣ1~4Ϊ/е//ؿAIGameModeȡֵͬ
+//        6  ִ׷           ͬ
+//        7               GameStatus
+//        8  ־             GAMELOG_HAS_STATSŷÿͳ
+//        9               0
+//       10             16λС
+//       12  ŷ             ÿһӱ row*̴С+col15·1ֽڣ19·ıų2552ֽС
+//           ÿͳ         ѡÿ3ֽڣȣ1ֽڣ˼ʱ루16λСˣⶥ65535
+#ifndef GAMELOG_H
+#define GAMELOG_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <mutex>
+#include "engine.h"
+
+#define GAMELOG_VERSION 1
+#define GAMELOG_HEADER_SIZE 12     // ¼ͷֽ
+#define GAMELOG_STAT_SIZE 3        // ÿͳƵֽ
+#define GAMELOG_HAS_STATS 0x01     // ־λÿͳ
+#define GAMELOG_MAX_RECORD (GAMELOG_HEADER_SIZE + MAX_BOARD_SIZE * MAX_BOARD_SIZE * (2 + GAMELOG_STAT_SIZE))   // һ¼ֽ
+
+// һӵͳƣµȫΪ0
+typedef struct {
+    int depth;                 // ɵȣóΪ0
+    int thinkMs;               // ˼ʱ룩
+} MoveStat;
+
+// һֱָָ֣ӳ־ݣ
+typedef struct {
+    int boardSize;
+    RuleMode rule;
+    int players[2];            // ִڡִ׷
+    GameStatus result;
+    int moveCount;             // 
+    int cellBytes;             // ÿӵŷֽ
+    const unsigned char* moves;
+    const unsigned char* stats;   // ÿͳƣûʱΪNULL
+} GameRecord;
+
+// ׷д־߳̿Թһ
+typedef struct {
+    FILE* file;
+    std::mutex lock;           // һ¼д룬֤߳¼¼
+    long long games;           // дľ
+} GameLogWriter;
+
+// ֻӳ־
+typedef struct {
+    const unsigned char* data;
+    size_t size;
+    size_t offset;             // һ¼λ
+#ifdef _WIN32
+    void* file;
+    void* mapping;
+#endif
+} GameLogReader;
+
+// д
+int gameLogCellBytes(int boardSize);
+bool gameLogOpen(GameLogWriter* log, const char* path);
+void gameLogClose(GameLogWriter* log);
+size_t gameLogEncode(unsigned char* buf, int boardSize, RuleMode rule, const int players[2], GameStatus result,
+                     const int moves[][2], int moveCount, const MoveStat* stats);
+bool gameLogAppend(GameLogWriter* log, int boardSize, RuleMode rule, const int players[2], GameStatus result,
+                   const int moves[][2], int moveCount, const MoveStat* stats);
+
+// ȡ
+bool gameLogMap(GameLogReader* reader, const char* path);
+void gameLogUnmap(GameLogReader* reader);
+bool gameLogNext(GameLogReader* reader, GameRecord* record);
+Position gameRecordMove(const GameRecord* record, int index);
+MoveStat gameRecordStat(const GameRecord* record, int index);
+
+#endif
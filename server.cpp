@@ -0,0 +1,338 @@
+// ỰԾַ񣺹ȡ̳߳Ự
+#include "server.h"
+#include <new>
+
+// ===== ȡ̳߳ =====
+
+thread_local int poolWorkerIndex = -1;    // ǰ̳߳߳еıţǹ߳ʱΪ-1
+
+// ԼĶβȡһûʱδͷ͵
+bool poolTake(ThreadPool* pool, int self, Task* task) {
+    TaskQueue* own = &pool->queues[self];
+    {
+        std::lock_guard<std::mutex> guard(own->lock);
+        if (own->tail != own->head) {
+            own->tail--;
+            *task = own->tasks[own->tail & own->mask];
+            return true;
+        }
+    }
+    for (int k = 1; k < pool->workerCount; k++) {
+        TaskQueue* victim = &pool->queues[(self + k) % pool->workerCount];
+        std::lock_guard<std::mutex> guard(victim->lock);
+        if (victim->tail != victim->head) {
+            *task = victim->tasks[victim->head & victim->mask];
+            victim->head++;
+            pool->stolen.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+// ִ̣߳Уûо˯ߣֹͣʱȰʣµ
+void poolWorker(ThreadPool* pool, int self) {
+    poolWorkerIndex = self;
+    while (true) {
+        Task task;
+        if (poolTake(pool, self, &task)) {
+            pool->pending.fetch_sub(1);
+            task.func(task.arg);
+            pool->executed.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+    
+        std::unique_lock<std::mutex> guard(pool->sleepLock);
+        TaskQueue* own = &pool->queues[self];
+        own->sleeping = true;
+        own->wake.wait(guard, [pool] {
+            return pool->pending.load() > 0 || pool->stopping.load();
+        });
+        own->sleeping = false;
+        if (pool->stopping.load() && pool->pending.load() == 0) {
+            break;
+        }
+    }
+}
+
+// workerṣ߳ÿqueueCapacityȡ2ݣ
+bool poolStart(ThreadPool* pool, int workers, int queueCapacity) {
+    if (workers < 1) workers = 1;
+    if (workers > POOL_MAX_WORKERS) workers = POOL_MAX_WORKERS;
+    unsigned int size = 16;
+    while (size < (unsigned int)queueCapacity) size *= 2;
+    
+    pool->queues = new TaskQueue[workers];
+    for (int i = 0; i < workers; i++) {
+        pool->queues[i].tasks = new Task[size];
+        pool->queues[i].mask = size - 1;
+        pool->queues[i].head = 0;
+        pool->queues[i].tail = 0;
+        pool->queues[i].sleeping = false;
+    }
+    pool->workerCount = workers;
+    pool->pending.store(0);
+    pool->nextQueue.store(0);
+    pool->stopping.store(false);
+    pool->executed.store(0);
+    pool->stolen.store(0);
+    pool->workers = new std::thread[workers];
+    for (int i = 0; i < workers; i++) {
+        pool->workers[i] = std::thread(poolWorker, pool, i);
+    }
+    return true;
+}
+
+// ύ񣺹߳ύԼĶУ̷߳homeָĶУhomeΪ-1ʱ
+void poolSubmit(ThreadPool* pool, TaskFunc func, void* arg, int home) {
+    int index = poolWorkerIndex;
+    if (index < 0 || index >= pool->workerCount) {
+        index = home;
+    }
+    if (index < 0 || index >= pool->workerCount) {
+        index = (int)(pool->nextQueue.fetch_add(1, std::memory_order_relaxed) % pool->workerCount);
+    }
+    
+    TaskQueue* queue = &pool->queues[index];
+    bool full;
+    {
+        std::lock_guard<std::mutex> guard(queue->lock);
+        full = (queue->tail - queue->head > queue->mask);
+        if (!full) {
+            queue->tasks[queue->tail & queue->mask].func = func;
+            queue->tasks[queue->tail & queue->mask].arg = arg;
+            queue->tail++;
+        }
+    }
+    if (full) {
+        // 󲢷䣬һ˾ύֱִ߳
+        func(arg);
+        return;
+    }
+    
+    pool->pending.fetch_add(1);
+    
+    // ȽѶеˣԼĶȡæʱһе߳͵
+    // sleepLock֪ͨڼ׼˯ߵĹ߳ͬⶪʧ
+    std::lock_guard<std::mutex> guard(pool->sleepLock);
+    for (int k = 0; k < pool->workerCount; k++) {
+        TaskQueue* target = &pool->queues[(index + k) % pool->workerCount];
+        if (target->sleeping) {
+            target->wake.notify_one();
+            break;
+        }
+    }
+}
+
+// ֹ̳ͣ߳أύȫִ˳
+void poolStop(ThreadPool* pool) {
+    {
+        std::lock_guard<std::mutex> guard(pool->sleepLock);
+        pool->stopping.store(true);
+        for (int i = 0; i < pool->workerCount; i++) {
+            pool->queues[i].wake.notify_one();
+        }
+    }
+    for (int i = 0; i < pool->workerCount; i++) {
+        pool->workers[i].join();
+    }
+    for (int i = 0; i < pool->workerCount; i++) {
+        delete[] pool->queues[i].tasks;
+    }
+    delete[] pool->workers;
+    delete[] pool->queues;
+    pool->workers = NULL;
+    pool->queues = NULL;
+    pool->workerCount = 0;
+}
+
+// ===== Ự =====
+
+template <int N> typename GameServer<N>::Session* GameServer<N>::sessions = NULL;   // Ự
+template <int N> int GameServer<N>::capacity = 0;                                    // ỰС
+template <int N> int GameServer<N>::freeHead = -1;                                   // ͷ
+template <int N> std::mutex GameServer<N>::freeLock;
+template <int N> ThreadPool* GameServer<N>::pool = NULL;                             // AIŷ̳߳
+template <int N> int GameServer<N>::hardTimeMs = 20;                                 // AIؿAIÿʱ
+template <int N> long long* GameServer<N>::latencyNs = NULL;                         // AIʱ
+template <int N> long long GameServer<N>::latencyCapacity = 0;
+template <int N> std::atomic<long long> GameServer<N>::latencyCount(0);
+template <int N> std::atomic<long long> GameServer<N>::gamesFinished(0);
+
+// ỰAIworkers̳߳ؼ㣬¼latencySamplesʱ
+template <int N>
+bool GameServer<N>::serverStart(int sessionCapacity, ThreadPool* workers, int hardMs, long long latencySamples) {
+    sessions = new (std::nothrow) Session[sessionCapacity];
+    latencyNs = new (std::nothrow) long long[latencySamples];
+    if (sessions == NULL || latencyNs == NULL) {
+        serverStop();
+        return false;
+    }
+    capacity = sessionCapacity;
+    for (int i = 0; i < capacity; i++) {
+        sessions[i].state.store(SS_FREE);
+        sessions[i].nextFree = (i + 1 < capacity) ? i + 1 : -1;
+    }
+    freeHead = (capacity > 0) ? 0 : -1;
+    pool = workers;
+    hardTimeMs = hardMs;
+    latencyCapacity = latencySamples;
+    resetStats();
+    return true;
+}
+
+// ͷŻỰǰӦ̳ͣ߳أ֤ûAIڼ
+template <int N>
+void GameServer<N>::serverStop() {
+    delete[] sessions;
+    delete[] latencyNs;
+    sessions = NULL;
+    latencyNs = NULL;
+    capacity = 0;
+    freeHead = -1;
+    latencyCapacity = 0;
+}
+
+template <int N>
+void GameServer<N>::resetStats() {
+    latencyCount.store(0);
+    gamesFinished.store(0);
+}
+
+// һ壬ػỰţỰʱ-1
+template <int N>
+int GameServer<N>::sessionOpen(GameMode mode, RuleMode rule) {
+    int id;
+    {
+        std::lock_guard<std::mutex> guard(freeLock);
+        id = freeHead;
+        if (id < 0) {
+            return -1;
+        }
+        freeHead = sessions[id].nextFree;
+    }
+    
+    Session* s = &sessions[id];
+    std::lock_guard<std::mutex> guard(s->lock);
+    C6::resetGame(&s->game, rule);
+    s->mode = mode;
+    s->home = id % pool->workerCount;
+    s->state.store(SS_CLIENT);
+    return id;
+}
+
+// رջỰAIڼʱӡAI񷢲״̬ʱԳs->lock
+// Ҫȷ״̬ΪУ֤Ự۽һʱѾ
+template <int N>
+void GameServer<N>::sessionClose(int id) {
+    Session* s = &sessions[id];
+    while (true) {
+        {
+            std::lock_guard<std::mutex> guard(s->lock);
+            if (s->state.load() != SS_AI) {
+                s->state.store(SS_FREE);
+                break;
+            }
+        }
+        std::this_thread::yield();
+    }
+    
+    std::lock_guard<std::mutex> guard(freeLock);
+    s->nextFree = freeHead;
+    freeHead = id;
+}
+
+// ͻڻỰidһӣֵͻ˻ŷǷʱfalseֵAIʱύ̳߳
+template <int N>
+bool GameServer<N>::sessionPlay(int id, int row, int col) {
+    Session* s = &sessions[id];
+    bool submit;
+    {
+        std::lock_guard<std::mutex> guard(s->lock);
+        if (s->state.load() != SS_CLIENT ||
+            !C6::playMove(&s->game, row, col, stoneOwner(s->game.rule, s->game.moveCount))) {
+            return false;
+        }
+        submit = afterMove(s);
+    }
+    if (submit) {
+        poolSubmit(pool, aiTask, s, s->home);
+    }
+    return true;
+}
+
+// һỰһ״̬ʱs->locktrueʾֵAIҪύ
+template <int N>
+bool GameServer<N>::afterMove(Session* s) {
+    typename C6::GameState* gs = &s->game;
+    if (gs->status != GS_PLAYING) {
+        s->state.store(SS_OVER);
+        gamesFinished.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    gs->currentPlayer = stoneOwner(gs->rule, gs->moveCount);
+    if (s->mode != GM_PVP && gs->currentPlayer == CT_WHITE) {
+        s->submitNs = nowNs();
+        s->state.store(SS_AI);
+        return true;
+    }
+    s->state.store(SS_CLIENT);
+    return false;
+}
+
+// ̳߳еAI״̬ΪSS_AIڼûб޸壬ԲֱӶ档
+// ͻ˵һŻ̵ִ߳ĶУӶβȡֻæʱű߳͵
+template <int N>
+void GameServer<N>::aiTask(void* arg) {
+    Session* s = (Session*)arg;
+    typename C6::GameState* gs = &s->game;
+    ChessType player = gs->currentPlayer;
+    s->home = poolWorkerIndex;     // ͵ߵĻỰӴ˹͵̣߳ǱߵĻ
+    SearchLimits limits = {hardTimeMs, searchMaxDepth, 1, NULL, NULL, mctsPlayouts};
+    
+    Position turn[2] = {{-1, -1}, {-1, -1}};
+    if (stonesToPlay(gs->rule, gs->moveCount) == 2) {
+        StonePair pair;
+        switch (s->mode) {
+            case GM_PVE_EASY: pair = C6::easyAIPair(&gs->board, player); break;
+            case GM_PVE_MEDIUM: pair = C6::mediumAIPair(&gs->board, player); break;
+            case GM_PVE_MCTS: pair = C6::mctsAIPairSearch(&gs->board, player, &limits); break;
+            default: pair = C6::hardAIPairSearch(&gs->board, player, &limits); break;
+        }
+        turn[0] = pair.first;
+        turn[1] = pair.second;
+    } else {
+        switch (s->mode) {
+            case GM_PVE_EASY: turn[0] = C6::easyAIMove(&gs->board, player); break;
+            case GM_PVE_MEDIUM: turn[0] = C6::mediumAIMove(&gs->board, player); break;
+            case GM_PVE_MCTS: turn[0] = C6::mctsSearch(&gs->board, player, gs->rule, &limits).first; break;
+            default: turn[0] = C6::hardAISearch(&gs->board, player, &limits); break;
+        }
+    }
+    
+    bool submit;
+    {
+        std::lock_guard<std::mutex> guard(s->lock);
+        bool placed = false;
+        for (int k = 0; k < 2 && turn[k].row >= 0 && gs->status == GS_PLAYING; k++) {
+            placed |= C6::playMove(gs, turn[k].row, turn[k].col, player);
+        }
+        if (!placed) {
+            // AIҲŷᷢԾУûỰס
+            gs->status = GS_DRAW;
+        }
+    
+        long long index = latencyCount.fetch_add(1, std::memory_order_relaxed);
+        if (index < latencyCapacity) {
+            latencyNs[index] = nowNs() - s->submitNs;
+        }
+        submit = afterMove(s);
+    }
+    if (submit) {
+        poolSubmit(pool, aiTask, s, s->home);
+    }
+}
+
+// ʽʵ̴ֵ֧С
+template struct GameServer<15>;
+template struct GameServer<19>;
@@ -0,0 +1,103 @@
+// ỰԾַһͬʱгǧ壬ÿỰһGameState
+// лỰAI󽻸Ĺȡ̳߳ؼ
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "engine.h"
+
+#define POOL_MAX_WORKERS 256       // ̳߳ص߳
+
+// ===== ȡ̳߳ =====
+
+typedef void (*TaskFunc)(void* arg);
+
+typedef struct {
+    TaskFunc func;
+    void* arg;
+} Task;
+
+// һ̵߳Уλ壩̴߳βȡȳݻڻ
+// е̴߳ͷ͵Ƚȳ͵ߵǵȵõ
+typedef struct {
+    std::mutex lock;
+    Task* tasks;
+    unsigned int mask;         // -1Ϊ2
+    unsigned int head;         // һ͵λ
+    unsigned int tail;         // һλ
+    std::condition_variable wake;  // еûʱȴ
+    bool sleeping;             // еڵȴ̳߳صsleepLock
+} TaskQueue;
+
+typedef struct {
+    TaskQueue* queues;         // ÿ߳һ
+    std::thread* workers;
+    int workerCount;
+    std::atomic<int> pending;              // ύûȡߵ
+    std::atomic<unsigned int> nextQueue;   // ⲿ߳ύûָʱĶ
+    std::atomic<bool> stopping;
+    std::mutex sleepLock;                  // ûʱ߳Լеwakeϵȴ
+    std::atomic<long long> executed;       // ͳƣִе
+    std::atomic<long long> stolen;         // ͳƣдӱĶ͵
+} ThreadPool;
+
+bool poolStart(ThreadPool* pool, int workers, int queueCapacity);
+bool poolTake(ThreadPool* pool, int self, Task* task);
+void poolWorker(ThreadPool* pool, int self);
+void poolSubmit(ThreadPool* pool, TaskFunc func, void* arg, int home);
+void poolStop(ThreadPool* pool);
+
+// ===== Ự =====
+
+// Ự״̬
+typedef enum {
+    SS_FREE,       // еĻỰ
+    SS_CLIENT,     // ȴͻ
+    SS_AI,         // AIύ̳߳Ŷӻ
+    SS_OVER        // Ծֽȴر
+} SessionState;
+
+// ̴СػĻỰỰͳǾ̬ģÿ̴Сһ
+template <int N>
+struct GameServer {
+    typedef Connect6<N> C6;
+    
+    // һỰͻִڣAIִ
+    typedef struct {
+        std::mutex lock;                   // gameͻӺAIӶҪ
+        std::atomic<int> state;            // SessionState
+        typename C6::GameState game;
+        GameMode mode;                     // AIGM_PVPʾɿͻ
+        long long submitNs;                // AIύʱ
+        int home;                          // һΪAIŷḶ́߳ȷŽĶ
+        int nextFree;                      // 
+    } Session;
+    
+    static Session* sessions;              // Ự
+    static int capacity;                   // ỰС
+    static int freeHead;                   // ͷ-1ʾ
+    static std::mutex freeLock;
+    static ThreadPool* pool;               // AIŷ̳߳
+    static int hardTimeMs;                 // AIؿAIÿʱ
+    static long long* latencyNs;           // AIύӵĺʱ
+    static long long latencyCapacity;
+    static std::atomic<long long> latencyCount;
+    static std::atomic<long long> gamesFinished;
+    
+    static bool serverStart(int sessionCapacity, ThreadPool* workers, int hardMs, long long latencySamples);
+    static void serverStop();
+    static void resetStats();
+    static int sessionOpen(GameMode mode, RuleMode rule);
+    static void sessionClose(int id);
+    static bool sessionPlay(int id, int row, int col);
+    static bool afterMove(Session* s);
+    static void aiTask(void* arg);
+};
+
+extern template struct GameServer<15>;
+extern template struct GameServer<19>;
+
+#endif
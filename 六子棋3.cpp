@@ -2,86 +2,110 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
-#include <stdbool.h>
 #include <string.h>
+#include "engine.h"
+#include "gamelog.h"
 
-#define BOARD_SIZE 15      // 15x15
-#define CELL_SIZE 40       // ÿӵشС
 #define OFFSET 50          // ̱߾
-#define WIN_COUNT 6        // ʤ
-#define MAX_MOVES 225      // 15*15
 
-// Ϸ״̬ö
+// AI˼״̬
 typedef enum {
-    GS_PLAYING,
-    GS_BLACK_WIN,
-    GS_WHITE_WIN,
-    GS_DRAW
-} GameStatus;
-
-// ö
-typedef enum {
-    CT_EMPTY,
-    CT_BLACK,
-    CT_WHITE
-} ChessType;
-
-// Ϸģʽö
-typedef enum {
-    GM_PVP,
-    GM_PVE_EASY,
-    GM_PVE_MEDIUM,
-    GM_PVE_HARD
-} GameMode;
-
-// ṹ
-typedef struct {
-    int row;
-    int col;
-} Position;
+    AJ_IDLE,       // û
+    AJ_RUNNING,    // ̨̼߳
+    AJ_DONE        // ȴϷѭȡ
+} AIJobState;
 
 // ȫֱ
-ChessType board[BOARD_SIZE][BOARD_SIZE];   // 
-GameStatus gameStatus = GS_PLAYING;        // Ϸ״̬
-ChessType currentPlayer = CT_BLACK;        // ǰ
+TimeControl timeControls[] = {             // GameMode˳
+    {TC_PER_MOVE, 0, 0, 0},                // ˫˶սʹ
+    {TC_PER_MOVE, 0, 0, 600},              // 򵥣˲ֻ꣬չʾʱ
+    {TC_PER_MOVE, 0, 0, 600},              // еȣͬ
+    {TC_TOTAL_CLOCK, 0, 60000, 300},       // ѣ60
+    {TC_TOTAL_CLOCK, 0, 60000, 300}        // ؿ壺ͬ
+};
+long long aiClockMs = 0;                   // AIʣ˼ʱ䣨룩
 GameMode gameMode = GM_PVP;                // Ϸģʽ
 bool gameStarted = false;                  // ϷǷʼ
-Position lastMove = {-1, -1};              // һλ
-int moveHistory[MAX_MOVES][2];             // ʷ¼
-int moveCount = 0;                         // ǰ
+int boardSize = 15;                       // ̴С1519·ڿʼ˵ѡ
+const char* gameLogPath = "games.c6log";   // ÿֽʱ׷ӵԾ־ʽgamelog.h
+const char* profileLogPath = "ai_profile.log";   // AIÿͳƺÿֽʱĻܣÿһJSON
+ProfileSummary sessionProfile;             // жԾAIÿͳƵĻ
 
 // 
-void initBoard();
 void showStartMenu();
-void showGameStartPrompt();
-void drawBoardBackground();
-void drawChess(int row, int col, ChessType type);
-void drawGameInfo();
-bool checkWin(int row, int col, ChessType player);
-bool isBoardFull();
-Position easyAIMove();
-Position mediumAIMove();
-Position hardAIMove();
-void makeMove(int row, int col, ChessType player);
-void aiMakeMove();
-void showEndMenu();
+void drawSettingOption(const RECT* rect, const char* text);
+void appendProfileLog(const char* kind, const char* fields);
+
+// һ̴СϷ棺ơӺAI˼ʹöӦߴʵ
+template <int N>
+struct Gui {
+    typedef Connect6<N> C6;
+    static constexpr int BOARD_SIZE = N;
+    static constexpr int CELL_SIZE = (N <= 15) ? 40 : 28;   // ÿӵشС19·СԷŽ
+    
+    // ں̨߳еAI˼Ϸѭȡ߽ӣڴڼճӦ
+    typedef struct {
+        typename C6::BoardState board;   // ʼ˼ʱľ渱
+        ChessType player;          // AIִɫ
+        GameMode mode;             // ʹһAI
+        SearchLimits limits;       // AI
+        long long startMs;         // ʼʱ
+        long long elapsedMs;       // ʵ˼ʱ
+        bool pair;                 // һǷӣ˫ӹ
+        Position result;           // ŷʱΪһӣ
+        Position second;           // ʱĵڶ
+        SearchProgress progress;   // ʵʱ
+        MoveProfile profile;       // һֵͳ
+        int shownDepth;            // ϢʾĽȣϷѭʹã
+        int shownMove;
+        std::atomic<bool> cancel;  // ȡ־¿ʼ򷵻˵ʱλ
+        std::atomic<int> state;    // AIJobState
+        std::thread worker;
+    } AIJob;
+
+    static typename C6::GameState game;    // ϵһ
+    static AIJob aiJob;                    // ڽеAI˼
+    static MoveStat moveStats[N * N];      // ÿӵAIͳƣʷӦдԾ־
+    static MoveProfile lastProfile;        // AIһֵͳƣʾҲ
+    static bool hasProfile;                // AIǷѾ߹
+    
+    static void initBoard();
+    static void showGameStartPrompt();
+    static void drawBoardBackground();
+    static void drawChess(int row, int col, ChessType type);
+    static void drawWinLine();
+    static void drawGameInfo();
+    static void drawProfilePanel();
+    static void makeMove(int row, int col, ChessType player);
+    static void redrawBoard();
+    static void undoTurn();
+    static void redoTurn();
+    static void aiJobWorker(AIJob* job);
+    static void aiMakeMove();
+    static void aiPoll();
+    static void aiCancel();
+    static void saveGameLog();
+    static void showEndMenu();
+    static void run();
+};
+
+template <int N> typename Connect6<N>::GameState Gui<N>::game;
+template <int N> typename Gui<N>::AIJob Gui<N>::aiJob;
+template <int N> MoveStat Gui<N>::moveStats[N * N];
+template <int N> MoveProfile Gui<N>::lastProfile;
+template <int N> bool Gui<N>::hasProfile = false;
 
 // ʼ
-void initBoard() {
-    for (int i = 0; i < BOARD_SIZE; i++) {
-        for (int j = 0; j < BOARD_SIZE; j++) {
-            board[i][j] = CT_EMPTY;
-        }
-    }
-    gameStatus = GS_PLAYING;
-    currentPlayer = CT_BLACK;
-    lastMove.row = -1;
-    lastMove.col = -1;
-    moveCount = 0;
+template <int N>
+void Gui<N>::initBoard() {
+    C6::resetGame(&game, ruleMode);
+    aiClockMs = timeControls[gameMode].totalTimeMs;
+    hasProfile = false;
 }
 
 // ʾϷʼʾ
-void showGameStartPrompt() {
+template <int N>
+void Gui<N>::showGameStartPrompt() {
     BeginBatchDraw();
     
     // ͸
@@ -105,6 +129,9 @@ void showGameStartPrompt() {
         case GM_PVE_HARD:
             strcpy(modeName, "˻սģʽ ()");
             break;
+        case GM_PVE_MCTS:
+            strcpy(modeName, "˻սģʽ (ؿ)");
+            break;
     }
     
     // ʾϷģʽ
@@ -114,6 +141,7 @@ void showGameStartPrompt() {
     settextstyle(24, 0, _T(""));
     outtextxy(200, 320, _T("ڷ "));
     outtextxy(200, 360, _T("λÿʼϷ..."));
+    outtextxy(200, 400, _T("ԾҼ壬м"));
     
     EndBatchDraw();
     
@@ -130,7 +158,8 @@ void showGameStartPrompt() {
 }
 
 // ̱
-void drawBoardBackground() {
+template <int N>
+void Gui<N>::drawBoardBackground() {
     // ñɫ
     setbkcolor(RGB(222, 184, 135));
     cleardevice();
@@ -151,23 +180,26 @@ void drawBoardBackground() {
              OFFSET + i * CELL_SIZE, OFFSET + (BOARD_SIZE - 1) * CELL_SIZE);
     }
     
-    // Ԫλ
+    // Ԫλ3ĽǺԪ19·ĸ
     setfillcolor(BLACK);
     int center = BOARD_SIZE / 2;
-    int smallPoints[4][2] = {
-        {3, 3}, {3, 11}, {11, 3}, {11, 11}
-    };
+    int starLines[3] = {3, center, BOARD_SIZE - 4};
     
-    fillcircle(OFFSET + center * CELL_SIZE, OFFSET + center * CELL_SIZE, 5);
-    for (int i = 0; i < 4; i++) {
-        fillcircle(OFFSET + smallPoints[i][1] * CELL_SIZE, 
-                  OFFSET + smallPoints[i][0] * CELL_SIZE, 5);
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            if (BOARD_SIZE < 19 && (i == 1) != (j == 1)) {
+                continue;
+            }
+            fillcircle(OFFSET + starLines[j] * CELL_SIZE, 
+                      OFFSET + starLines[i] * CELL_SIZE, 5);
+        }
     }
 }
 
 // 
 
-void drawChess(int row, int col, ChessType type) {
+template <int N>
+void Gui<N>::drawChess(int row, int col, ChessType type) {
     if (row < 0 || row >= BOARD_SIZE || col < 0 || col >= BOARD_SIZE) {
         return;
     }
@@ -190,8 +222,30 @@ void drawChess(int row, int col, ChessType type) {
               OFFSET + row * CELL_SIZE, 
               CELL_SIZE / 2 - 2);
 }
+// ֳʤӵһϻ߲Ȧÿһ
+template <int N>
+void Gui<N>::drawWinLine() {
+    if (game.status != GS_BLACK_WIN && game.status != GS_WHITE_WIN) {
+        return;
+    }
+    Position from = game.winLine[0];
+    Position to = game.winLine[1];
+    int dr = (to.row > from.row) - (to.row < from.row);
+    int dc = (to.col > from.col) - (to.col < from.col);
+    
+    setlinecolor(RED);
+    setlinestyle(PS_SOLID, 3);
+    for (int row = from.row, col = from.col; ; row += dr, col += dc) {
+        circle(OFFSET + col * CELL_SIZE, OFFSET + row * CELL_SIZE, CELL_SIZE / 2 - 2);
+        if (row == to.row && col == to.col) break;
+    }
+    line(OFFSET + from.col * CELL_SIZE, OFFSET + from.row * CELL_SIZE,
+         OFFSET + to.col * CELL_SIZE, OFFSET + to.row * CELL_SIZE);
+}
+
 // ϷϢ
-void drawGameInfo() {
+template <int N>
+void Gui<N>::drawGameInfo() {
     // Ϣ򱳾
     setfillcolor(RGB(240, 240, 240));
     fillrectangle(10, 10, 790, 40);
@@ -199,22 +253,27 @@ void drawGameInfo() {
     settextcolor(BLACK);
     settextstyle(20, 0, _T(""));
     
-    if (gameStatus == GS_PLAYING) {
+    if (game.status == GS_PLAYING) {
         char msg[50];
-        if (currentPlayer == CT_BLACK) {
-            sprintf(msg, "ǰ: ڷ  (: %d)", moveCount);
+        int depth = aiJob.progress.depth.load();
+        int move = aiJob.progress.move.load();
+        if (game.currentPlayer == CT_BLACK) {
+            sprintf(msg, "ǰ: ڷ  (: %d)", game.moveCount);
+        } else if (aiJob.state.load() != AJ_IDLE && depth > 0 && move >= 0) {
+            // AI˼Уʾǰŷ
+            sprintf(msg, "׷˼: %c%d (: %d)", 'A' + move % BOARD_SIZE, move / BOARD_SIZE + 1, depth);
         } else {
-            sprintf(msg, "ǰ: ׷  (: %d)", moveCount);
+            sprintf(msg, "ǰ: ׷  (: %d)", game.moveCount);
         }
         outtextxy(20, 15, msg);
     } else {
         char result[50];
-        if (gameStatus == GS_BLACK_WIN) {
-            sprintf(result, "Ϸ! ڷʤ! (ܲ: %d)", moveCount);
-        } else if (gameStatus == GS_WHITE_WIN) {
-            sprintf(result, "Ϸ! ׷ʤ! (ܲ: %d)", moveCount);
+        if (game.status == GS_BLACK_WIN) {
+            sprintf(result, "Ϸ! ڷʤ! (ܲ: %d)", game.moveCount);
+        } else if (game.status == GS_WHITE_WIN) {
+            sprintf(result, "Ϸ! ׷ʤ! (ܲ: %d)", game.moveCount);
         } else {
-            sprintf(result, "Ϸ! ƽ! (ܲ: %d)", moveCount);
+            sprintf(result, "Ϸ! ƽ! (ܲ: %d)", game.moveCount);
         }
         outtextxy(20, 15, result);
     }
@@ -227,389 +286,304 @@ void drawGameInfo() {
         sprintf(modeMsg, "ģʽ: ˻ս()");
     } else if (gameMode == GM_PVE_MEDIUM) {
         sprintf(modeMsg, "ģʽ: ˻ս(е)");
+    } else if (gameMode == GM_PVE_MCTS) {
+        sprintf(modeMsg, "ģʽ: ˻ս(ؿ)");
     } else {
         sprintf(modeMsg, "ģʽ: ˻ս()");
     }
     outtextxy(400, 15, modeMsg);
     
     // һʾ
-    if (lastMove.row != -1) {
+    if (game.lastMove.row != -1) {
         char lastMoveMsg[50];
-        sprintf(lastMoveMsg, "һ: %c%d", 'A' + lastMove.col, lastMove.row + 1);
+        sprintf(lastMoveMsg, "һ: %c%d", 'A' + game.lastMove.col, game.lastMove.row + 1);
         outtextxy(600, 15, lastMoveMsg);
     }
+    
+    if (hasProfile && gameMode != GM_PVP) {
+        drawProfilePanel();
+    }
 }
 
-// жǷʤ
-bool checkWin(int row, int col, ChessType player) {
-    // 鷽: ˮƽֱԽߡԽ
-    int directions[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+// ҲAIһֵͳ
+template <int N>
+void Gui<N>::drawProfilePanel() {
+    const MoveProfile* p = &lastProfile;
+    long long probes = p->delta.counters[EC_TT_PROBES];
+    char lines[10][40];
+    sprintf(lines[0], "AIһ");
+    sprintf(lines[1], "ʱ: %lld ms", p->wallNs / 1000000);
+    sprintf(lines[2], ": %d", p->depth);
+    sprintf(lines[3], "ڵ: %lld", p->delta.counters[EC_NODES]);
+    sprintf(lines[4], "вڵ: %lld", p->delta.counters[EC_THREAT_NODES]);
+    sprintf(lines[5], "ж: %lld", p->delta.counters[EC_WIN_PROBES]);
+    sprintf(lines[6], "û: %lld%%", probes ? p->delta.counters[EC_TT_HITS] * 100 / probes : 0);
+    sprintf(lines[7], ": %lld ms", profileTimerNs(p, ET_SCORING) / 1000000);
+    sprintf(lines[8], "в: %lld ms", profileTimerNs(p, ET_THREATS) / 1000000);
+    sprintf(lines[9], "ģ: %lld", p->delta.counters[EC_PLAYOUTS]);
     
-    for (int d = 0; d < 4; d++) {
-        int count = 1;
-        
-        // 
-        int r = row + directions[d][0];
-        int c = col + directions[d][1];
-        while (r >= 0 && r < BOARD_SIZE && c >= 0 && c < BOARD_SIZE && 
-               board[r][c] == player) {
-            count++;
-            r += directions[d][0];
-            c += directions[d][1];
-        }
-        
-        // 
-        r = row - directions[d][0];
-        c = col - directions[d][1];
-        while (r >= 0 && r < BOARD_SIZE && c >= 0 && c < BOARD_SIZE && 
-               board[r][c] == player) {
-            count++;
-            r -= directions[d][0];
-            c -= directions[d][1];
-        }
-        
-        if (count >= WIN_COUNT) {
-            // ʾʤ
-            
-            return true;
-        }
+    setfillcolor(RGB(240, 240, 240));
+    fillrectangle(640, 50, 790, 293);
+    settextcolor(BLACK);
+    settextstyle(16, 0, _T(""));
+    for (int i = 0; i < 10; i++) {
+        outtextxy(650, 58 + i * 23, lines[i]);
     }
-    
-    return false;
 }
 
-// Ƿ
-bool isBoardFull() {
-    return moveCount >= BOARD_SIZE * BOARD_SIZE;
-}
 
-// ͷĽ
-int evaluatePattern(int playerCount, int opponentCount, int emptyCount, int length) {
-    if (playerCount == length && emptyCount > 0) {
-        // 
-        if (length == 6) return 10000;
-        if (length == 5) return 1000;
-        if (length == 4) return 100;
-        if (length == 3) return 10;
-        if (length == 2) return 1;
-    } else if (playerCount == length && emptyCount == 0) {
-        // 
-        if (length == 6) return 5000;
-        if (length == 5) return 500;
-        if (length == 4) return 50;
-        if (length == 3) return 5;
+// ӣжֻ
+template <int N>
+void Gui<N>::makeMove(int row, int col, ChessType player) {
+    if (C6::playMove(&game, row, col, player)) {
+        // Ѿı䣬ͣº̨˼
+        C6::ponderStop();
+        moveStats[game.moveCount - 1].depth = 0;
+        moveStats[game.moveCount - 1].thinkMs = 0;
+        
+        BeginBatchDraw();
+        drawChess(row, col, player);
+        drawWinLine();
+        drawGameInfo();
+        EndBatchDraw();
     }
-    return 0;
 }
 
-// AI - 
-Position easyAIMove() {
-    Position pos = {-1, -1};
-    int emptyCount = 0;
-    Position emptyPositions[BOARD_SIZE * BOARD_SIZE];
+// ػ̣塢ʹ
+template <int N>
+void Gui<N>::redrawBoard() {
+    BeginBatchDraw();
+    drawBoardBackground();
+    for (int i = 0; i < game.moveCount; i++) {
+        int row = game.moveHistory[i][0];
+        int col = game.moveHistory[i][1];
+        drawChess(row, col, C6::bitboardGet(&game.board.bits, row, col));
+    }
+    drawWinLine();
+    drawGameInfo();
+    EndBatchDraw();
+}
+
+// 壺˻սʱͬAIӦһ𳷻أصӵʱ
+template <int N>
+void Gui<N>::undoTurn() {
+    aiCancel();
+    C6::ponderStop();
     
-    // ռпλ
-    for (int i = 0; i < BOARD_SIZE; i++) {
-        for (int j = 0; j < BOARD_SIZE; j++) {
-            if (board[i][j] == CT_EMPTY) {
-                emptyPositions[emptyCount].row = i;
-                emptyPositions[emptyCount].col = j;
-                emptyCount++;
-            }
-        }
+    if (!C6::undoMove(&game)) {
+        return;
     }
-    
-    if (emptyCount > 0) {
-        int index = rand() % emptyCount;
-        pos = emptyPositions[index];
+    while (gameMode != GM_PVP && game.currentPlayer == CT_WHITE && C6::undoMove(&game)) {
     }
-    
-    return pos;
+    redrawBoard();
 }
 
-// еAI - 
-Position mediumAIMove() {
-    Position bestPos = {-1, -1};
-    int bestScore = -1;
-    
-    // 1. ԼǷʤ
-    for (int i = 0; i < BOARD_SIZE; i++) {
-        for (int j = 0; j < BOARD_SIZE; j++) {
-            if (board[i][j] == CT_EMPTY) {
-                board[i][j] = CT_WHITE;
-                if (checkWin(i, j, CT_WHITE)) {
-                    board[i][j] = CT_EMPTY;
-                    bestPos.row = i;
-                    bestPos.col = j;
-                    return bestPos;
-                }
-                board[i][j] = CT_EMPTY;
-            }
-        }
+// ڵ壺˻սʱһһֵңAIӦûм¼ʱAI˼
+template <int N>
+void Gui<N>::redoTurn() {
+    if (aiJob.state.load() != AJ_IDLE || game.moveCount >= game.historyLength) {
+        return;
     }
-    
-    // 2. ǷҪֹڷʤ
-    for (int i = 0; i < BOARD_SIZE; i++) {
-        for (int j = 0; j < BOARD_SIZE; j++) {
-            if (board[i][j] == CT_EMPTY) {
-                board[i][j] = CT_BLACK;
-                if (checkWin(i, j, CT_BLACK)) {
-                    board[i][j] = CT_EMPTY;
-                    bestPos.row = i;
-                    bestPos.col = j;
-                    return bestPos;
-                }
-                board[i][j] = CT_EMPTY;
-            }
-        }
+    // Ҫˣͣº̨˼AIԤʱ̨ܻ߳̿д
+    C6::ponderStop();
+    if (!C6::redoMove(&game)) {
+        return;
     }
-    
-    // 3. ÿλķ
-    for (int i = 0; i < BOARD_SIZE; i++) {
-        for (int j = 0; j < BOARD_SIZE; j++) {
-            if (board[i][j] == CT_EMPTY) {
-                int score = 0;
-                
-                // ĸ
-                int directions[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
-                
-                for (int d = 0; d < 4; d++) {
-                    // ӣAI
-                    int whiteCount = 1;
-                    int emptyCount = 0;
-                    
-                    // 
-                    int r = i + directions[d][0];
-                    int c = j + directions[d][1];
-                    while (r >= 0 && r < BOARD_SIZE && c >= 0 && c < BOARD_SIZE) {
-                        if (board[r][c] == CT_WHITE) whiteCount++;
-                        else if (board[r][c] == CT_EMPTY) emptyCount++;
-                        else break;
-                        r += directions[d][0];
-                        c += directions[d][1];
-                    }
-                    
-                    // 
-                    r = i - directions[d][0];
-                    c = j - directions[d][1];
-                    while (r >= 0 && r < BOARD_SIZE && c >= 0 && c < BOARD_SIZE) {
-                        if (board[r][c] == CT_WHITE) whiteCount++;
-                        else if (board[r][c] == CT_EMPTY) emptyCount++;
-                        else break;
-                        r -= directions[d][0];
-                        c -= directions[d][1];
-                    }
-                    
-                    score += evaluatePattern(whiteCount, 0, emptyCount, whiteCount);
-                    
-                    // ӣңͲ
-                    int blackCount = 1;
-                    emptyCount = 0;
-                    
-                    // 
-                    r = i + directions[d][0];
-                    c = j + directions[d][1];
-                    while (r >= 0 && r < BOARD_SIZE && c >= 0 && c < BOARD_SIZE) {
-                        if (board[r][c] == CT_BLACK) blackCount++;
-                        else if (board[r][c] == CT_EMPTY) emptyCount++;
-                        else break;
-                        r += directions[d][0];
-                        c += directions[d][1];
-                    }
-                    
-                    // 
-                    r = i - directions[d][0];
-                    c = j - directions[d][1];
-                    while (r >= 0 && r < BOARD_SIZE && c >= 0 && c < BOARD_SIZE) {
-                        if (board[r][c] == CT_BLACK) blackCount++;
-                        else if (board[r][c] == CT_EMPTY) emptyCount++;
-                        else break;
-                        r -= directions[d][0];
-                        c -= directions[d][1];
-                    }
-                    
-                    // طȽ
-                    score += evaluatePattern(blackCount, 0, emptyCount, blackCount) * 2;
-                }
-                
-                // λüӷ
-                int center = BOARD_SIZE / 2;
-                int distance = abs(i - center) + abs(j - center);
-                score += (BOARD_SIZE - distance) * 2;
-                
-                // λ
-                if (score > bestScore) {
-                    bestScore = score;
-                    bestPos.row = i;
-                    bestPos.col = j;
-                }
-            }
-        }
+    while (gameMode != GM_PVP && game.status == GS_PLAYING &&
+           game.currentPlayer == CT_WHITE && C6::redoMove(&game)) {
     }
+    redrawBoard();
     
-    return bestPos;
+    if (gameMode != GM_PVP && game.status == GS_PLAYING && game.currentPlayer == CT_WHITE) {
+        aiMakeMove();
+    }
 }
 
-// AI - ƣ
-Position hardAIMove() {
-    Position bestPos = {-1, -1};
-    
-    // 1. ʤ
-    for (int i = 0; i < BOARD_SIZE; i++) {
-        for (int j = 0; j < BOARD_SIZE; j++) {
-            if (board[i][j] == CT_EMPTY) {
-                board[i][j] = CT_WHITE;
-                if (checkWin(i, j, CT_WHITE)) {
-                    board[i][j] = CT_EMPTY;
-                    bestPos.row = i;
-                    bestPos.col = j;
-                    return bestPos;
-                }
-                board[i][j] = CT_EMPTY;
-            }
+// AI˼ḷֻ̨́߳Լľ渱κλͼ
+template <int N>
+void Gui<N>::aiJobWorker(AIJob* job) {
+    Position move = {-1, -1};
+    StonePair pair = {{-1, -1}, {-1, -1}};
+    profileBegin(&job->profile);
+    if (job->pair) {
+        switch (job->mode) {
+            case GM_PVE_EASY:
+                pair = C6::easyAIPair(&job->board, job->player);
+                break;
+            case GM_PVE_MEDIUM:
+                pair = C6::mediumAIPair(&job->board, job->player);
+                break;
+            case GM_PVE_HARD:
+                pair = C6::hardAIPairSearch(&job->board, job->player, &job->limits);
+                break;
+            case GM_PVE_MCTS:
+                pair = C6::mctsAIPairSearch(&job->board, job->player, &job->limits);
+                break;
+            default:
+                break;
         }
+        job->result = pair.first;
+        job->second = pair.second;
+        profileEnd(&job->profile);
+        job->elapsedMs = nowMs() - job->startMs;
+        job->state.store(AJ_DONE);
+        return;
     }
     
-    // 2. Ҽʤ
-    for (int i = 0; i < BOARD_SIZE; i++) {
-        for (int j = 0; j < BOARD_SIZE; j++) {
-            if (board[i][j] == CT_EMPTY) {
-                board[i][j] = CT_BLACK;
-                if (checkWin(i, j, CT_BLACK)) {
-                    board[i][j] = CT_EMPTY;
-                    bestPos.row = i;
-                    bestPos.col = j;
-                    return bestPos;
-                }
-                board[i][j] = CT_EMPTY;
+    switch (job->mode) {
+        case GM_PVE_EASY:
+            move = C6::easyAIMove(&job->board, job->player);
+            break;
+        case GM_PVE_MEDIUM:
+            move = C6::mediumAIMove(&job->board, job->player);
+            break;
+        case GM_PVE_HARD:
+            // ҵԤ֮ʱֱų́˼Ľ
+            if (!C6::ponderLookup(job->board.hash, &move)) {
+                move = C6::hardAISearch(&job->board, job->player, &job->limits);
             }
-        }
+            break;
+        case GM_PVE_MCTS:
+            move = C6::mctsSearch(&job->board, job->player, ruleMode, &job->limits).first;
+            break;
+        default:
+            break;
     }
-    
-    // 3. һĽģһ
-    int maxScore = -10000;
-    
-    for (int i = 0; i < BOARD_SIZE; i++) {
-        for (int j = 0; j < BOARD_SIZE; j++) {
-            if (board[i][j] == CT_EMPTY) {
-                // ڴ
-                board[i][j] = CT_WHITE;
-                
-                // λõķ
-                int score = 0;
-                
-                // 
-                for (int k = 0; k < BOARD_SIZE; k++) {
-                    for (int l = 0; l < BOARD_SIZE; l++) {
-                        if (board[k][l] == CT_EMPTY) {
-                            board[k][l] = CT_WHITE;
-                            if (checkWin(k, l, CT_WHITE)) {
-                                score += 100;
-                            }
-                            board[k][l] = CT_EMPTY;
-                            
-                            board[k][l] = CT_BLACK;
-                            if (checkWin(k, l, CT_BLACK)) {
-                                score -= 150;  // ظҪ
-                            }
-                            board[k][l] = CT_EMPTY;
-                        }
-                    }
-                }
-                
-                // ĿƷ
-                int center = BOARD_SIZE / 2;
-                int distance = abs(i - center) + abs(j - center);
-                score += (BOARD_SIZE - distance) * 3;
-                
-                // Էӵӣ
-                for (int di = -1; di <= 1; di++) {
-                    for (int dj = -1; dj <= 1; dj++) {
-                        if (di == 0 && dj == 0) continue;
-                        int ni = i + di;
-                        int nj = j + dj;
-                        if (ni >= 0 && ni < BOARD_SIZE && nj >= 0 && nj < BOARD_SIZE) {
-                            if (board[ni][nj] == CT_WHITE) score += 5;
-                            else if (board[ni][nj] == CT_BLACK) score += 3;
-                        }
-                    }
-                }
-                
-                // ָ
-                board[i][j] = CT_EMPTY;
-                
-                if (score > maxScore) {
-                    maxScore = score;
-                    bestPos.row = i;
-                    bestPos.col = j;
-                }
-            }
-        }
+    job->result = move;
+    profileEnd(&job->profile);
+    job->elapsedMs = nowMs() - job->startMs;
+    job->state.store(AJ_DONE);
+}
+
+// AIʼ˼ں̨߳м㣬aiPollȡ
+template <int N>
+void Gui<N>::aiMakeMove() {
+    if (game.status != GS_PLAYING || game.currentPlayer != CT_WHITE || gameMode == GM_PVP) {
+        return;
     }
-    
-    return bestPos;
+    aiCancel();
+    
+    const TimeControl* tc = &timeControls[gameMode];
+    searchTimeMs = C6::allocateMoveTime(tc, aiClockMs, game.rule, game.moveCount);
+    
+    aiJob.board = game.board;
+    aiJob.player = CT_WHITE;
+    aiJob.mode = gameMode;
+    aiJob.limits.timeLimitMs = searchTimeMs;
+    aiJob.limits.maxDepth = searchMaxDepth;
+    aiJob.limits.threads = searchThreads;
+    aiJob.limits.cancel = &aiJob.cancel;
+    aiJob.limits.progress = &aiJob.progress;
+    aiJob.limits.playouts = mctsPlayouts;
+    aiJob.startMs = nowMs();
+    aiJob.elapsedMs = 0;
+    aiJob.pair = (stonesToPlay(game.rule, game.moveCount) == 2);
+    aiJob.result.row = -1;
+    aiJob.result.col = -1;
+    aiJob.second.row = -1;
+    aiJob.second.col = -1;
+    aiJob.progress.depth.store(0);
+    aiJob.progress.move.store(-1);
+    aiJob.shownDepth = 0;
+    aiJob.shownMove = -1;
+    aiJob.cancel.store(false);
+    aiJob.state.store(AJ_RUNNING);
+    aiJob.worker = std::thread(aiJobWorker, &aiJob);
 }
 
-// 
-void makeMove(int row, int col, ChessType player) {
-    if (row < 0 || row >= BOARD_SIZE || col < 0 || col >= BOARD_SIZE) {
+// Ϸѭÿֵãˢ˼ȣ
+template <int N>
+void Gui<N>::aiPoll() {
+    int state = aiJob.state.load();
+    if (state == AJ_IDLE) {
         return;
     }
     
-    if (board[row][col] == CT_EMPTY && gameStatus == GS_PLAYING) {
-        board[row][col] = player;
-        moveHistory[moveCount][0] = row;
-        moveHistory[moveCount][1] = col;
-        moveCount++;
-        lastMove.row = row;
-        lastMove.col = col;
-        
-        BeginBatchDraw();
-        drawChess(row, col, player);
-        drawGameInfo();
-        EndBatchDraw();
-        
-        // Ƿʤ
-        if (checkWin(row, col, player)) {
-            gameStatus = (player == CT_BLACK) ? GS_BLACK_WIN : GS_WHITE_WIN;
-        } else if (isBoardFull()) {
-            gameStatus = GS_DRAW;
+    if (state == AJ_RUNNING) {
+        int depth = aiJob.progress.depth.load();
+        int move = aiJob.progress.move.load();
+        if (depth != aiJob.shownDepth || move != aiJob.shownMove) {
+            aiJob.shownDepth = depth;
+            aiJob.shownMove = move;
+            BeginBatchDraw();
+            drawGameInfo();
+            EndBatchDraw();
         }
-    }
-}
-
-// AI
-void aiMakeMove() {
-    if (gameStatus != GS_PLAYING || currentPlayer != CT_WHITE) {
         return;
     }
     
-    Position aiMove;
+    // ñչʾʱʱȵչʾʱӣڼճӦ
+    const TimeControl* tc = &timeControls[aiJob.mode];
+    if (nowMs() - aiJob.startMs < tc->minDisplayMs) {
+        return;
+    }
     
-    switch (gameMode) {
-        case GM_PVE_EASY:
-            aiMove = easyAIMove();
-            break;
-        case GM_PVE_MEDIUM:
-            aiMove = mediumAIMove();
-            break;
-        case GM_PVE_HARD:
-            aiMove = hardAIMove();
-            break;
-        default:
-            return;
+    aiJob.worker.join();
+    aiJob.state.store(AJ_IDLE);
+    if (tc->type == TC_TOTAL_CLOCK) {
+        aiClockMs = (aiClockMs > aiJob.elapsedMs) ? aiClockMs - aiJob.elapsedMs : 0;
     }
     
+    // һֵͳƣϢʾ׷ӵͳ־뱾еĻ
+    lastProfile = aiJob.profile;
+    hasProfile = true;
+    summaryAdd(&sessionProfile, &lastProfile);
+    char fields[1024];
+    int length = sprintf(fields, "\"mode\":%d,\"stone\":%d,", (int)aiJob.mode, game.moveCount);
+    profileFormat(&lastProfile, fields + length, sizeof(fields) - length);
+    appendProfileLog("move", fields);
+    
+    Position aiMove = aiJob.result;
     if (aiMove.row != -1 && aiMove.col != -1) {
-        // ӳ٣ģ˼
-        Sleep(500 + rand() % 500);
-        
-        makeMove(aiMove.row, aiMove.col, CT_WHITE);
-        if (gameStatus == GS_PLAYING) {
-            currentPlayer = CT_BLACK;
+        makeMove(aiMove.row, aiMove.col, aiJob.player);
+        moveStats[game.moveCount - 1].depth = aiJob.progress.depth.load();
+        moveStats[game.moveCount - 1].thinkMs = (int)aiJob.elapsedMs;
+        if (game.status == GS_PLAYING && aiJob.second.row != -1) {
+            makeMove(aiJob.second.row, aiJob.second.col, aiJob.player);
+        }
+        if (game.status == GS_PLAYING) {
+            game.currentPlayer = stoneOwner(game.rule, game.moveCount);
             drawGameInfo();
+            // ˼ڼں̨Ԥȼ㣨ֻԤⵥӦţ
+            if (gameMode == GM_PVE_HARD && game.rule == RULE_ONE_STONE && game.currentPlayer != aiJob.player) {
+                C6::ponderStart(&game.board, aiJob.player);
+            }
         }
     }
+    
+    // һûֻһӣʱֵAI˼Ծֻͣ
+    if (game.status == GS_PLAYING && game.currentPlayer == CT_WHITE) {
+        aiMakeMove();
+    }
+}
+
+// ȡڽеAI˼ȴ̨߳˳
+template <int N>
+void Gui<N>::aiCancel() {
+    if (aiJob.worker.joinable()) {
+        aiJob.cancel.store(true);
+        aiJob.worker.join();
+    }
+    aiJob.state.store(AJ_IDLE);
+}
+
+// һͳ׷ӵͳ־дȥʱӰϷ
+void appendProfileLog(const char* kind, const char* fields) {
+    FILE* file = fopen(profileLogPath, "a");
+    if (file == NULL) {
+        return;
+    }
+    fprintf(file, "{\"profile\":\"%s\",\"size\":%d,%s}\n", kind, boardSize, fields);
+    fclose(file);
+}
+
+// ƿʼ˵ѡ̴С򣩣л
+void drawSettingOption(const RECT* rect, const char* text) {
+    setfillcolor(RGB(176, 224, 230));
+    fillroundrect(rect->left, rect->top, rect->right, rect->bottom, 10, 10);
+    settextstyle(20, 0, _T(""));
+    settextcolor(BLACK);
+    outtextxy(rect->left + 15, rect->top + 10, text);
 }
 
 // ʾʼ˵
@@ -630,7 +604,23 @@ void showStartMenu() {
     int optionsY = 250;
     int optionHeight = 50;
     
-    RECT options[5];
+    RECT options[8];
+    
+    // ̴С15·19·֮л
+    options[5].left = 250;
+    options[5].top = optionsY - optionHeight - 10;
+    options[5].right = 395;
+    options[5].bottom = optionsY - 20;
+    drawSettingOption(&options[5], boardSize == 19 ? _T(": 19·") : _T(": 15·"));
+    
+    // ӹ򣬵ÿһӺͱ׼ÿ֮л
+    options[6].left = 405;
+    options[6].top = optionsY - optionHeight - 10;
+    options[6].right = 550;
+    options[6].bottom = optionsY - 20;
+    drawSettingOption(&options[6], ruleMode == RULE_CONNECT6 ? _T(": ÿ") : _T(": ÿһ"));
+    
+    settextstyle(24, 0, _T(""));
     
     // ˫˶ս
     options[0].left = 250;
@@ -676,7 +666,7 @@ void showStartMenu() {
                   options[3].right, options[3].bottom, 10, 10);
     outtextxy(320, optionsY + 3 * optionHeight + 5, _T("4. ˻ս ()"));
     
-    // ˳Ϸ
+    // ˻սؿ
     options[4].left = 250;
     options[4].top = optionsY + 4 * optionHeight;
     options[4].right = 550;
@@ -685,10 +675,21 @@ void showStartMenu() {
     setfillcolor(RGB(255, 228, 181));
     fillroundrect(options[4].left, options[4].top, 
                   options[4].right, options[4].bottom, 10, 10);
-    outtextxy(320, optionsY + 4 * optionHeight + 5, _T("5. ˳Ϸ"));
+    outtextxy(300, optionsY + 4 * optionHeight + 5, _T("5. ˻ս (ؿ)"));
+    
+    // ˳Ϸ
+    options[7].left = 250;
+    options[7].top = optionsY + 5 * optionHeight;
+    options[7].right = 550;
+    options[7].bottom = optionsY + 5 * optionHeight + 40;
+    
+    setfillcolor(RGB(255, 228, 181));
+    fillroundrect(options[7].left, options[7].top, 
+                  options[7].right, options[7].bottom, 10, 10);
+    outtextxy(320, optionsY + 5 * optionHeight + 5, _T("6. ˳Ϸ"));
     
     settextstyle(18, 0, _T(""));
-    outtextxy(280, 550, _T("ʹѡϷģʽ"));
+    outtextxy(280, 555, _T("ʹѡϷģʽ"));
     
     EndBatchDraw();
     
@@ -696,24 +697,35 @@ void showStartMenu() {
     while (true) {
         MOUSEMSG msg = GetMouseMsg();
         if (msg.uMsg == WM_LBUTTONDOWN) {
-            for (int i = 0; i < 5; i++) {
+            for (int i = 0; i < 8; i++) {
                 if (msg.x >= options[i].left && msg.x <= options[i].right &&
                     msg.y >= options[i].top && msg.y <= options[i].bottom) {
                     
+                    if (i == 5) {
+                        boardSize = (boardSize == 15) ? 19 : 15;
+                        BeginBatchDraw();
+                        drawSettingOption(&options[5], boardSize == 19 ? _T(": 19·") : _T(": 15·"));
+                        EndBatchDraw();
+                        break;
+                    }
+                    if (i == 6) {
+                        ruleMode = (ruleMode == RULE_CONNECT6) ? RULE_ONE_STONE : RULE_CONNECT6;
+                        BeginBatchDraw();
+                        drawSettingOption(&options[6], ruleMode == RULE_CONNECT6 ? _T(": ÿ") : _T(": ÿһ"));
+                        EndBatchDraw();
+                        break;
+                    }
+                    
                     switch (i) {
                         case 0: gameMode = GM_PVP; break;
                         case 1: gameMode = GM_PVE_EASY; break;
                         case 2: gameMode = GM_PVE_MEDIUM; break;
                         case 3: gameMode = GM_PVE_HARD; break;
-                        case 4: exit(0);
+                        case 4: gameMode = GM_PVE_MCTS; break;
+                        case 7: exit(0);
                     }
                     
                     gameStarted = true;
-                    initBoard();
-                    
-                    // ʾϷʼʾ
-                    showGameStartPrompt();
-                    
                     return;
                 }
             }
@@ -722,8 +734,28 @@ void showStartMenu() {
     }
 }
 
+// ѽһ׷ӵԾ־дȥʱӰϷڽ˵뿪һʱãÿֻдһ
+template <int N>
+void Gui<N>::saveGameLog() {
+    GameLogWriter log;
+    if (!gameLogOpen(&log, gameLogPath)) {
+        return;
+    }
+    int players[2] = {0, (gameMode == GM_PVP) ? 0 : (int)gameMode};   // ִ
+    gameLogAppend(&log, N, game.rule, players, game.status, game.moveHistory, game.moveCount, moveStats);
+    gameLogClose(&log);
+    
+    // еĿǰΪֹĻֱܺͼÿֽʱ׷һУһмỰͳ
+    if (sessionProfile.moves > 0) {
+        char fields[4096];
+        summaryFormat(&sessionProfile, fields, sizeof(fields));
+        appendProfileLog("session", fields);
+    }
+}
+
 // ʾ
-void showEndMenu() {
+template <int N>
+void Gui<N>::showEndMenu() {
     // ȴһʱʾ
     Sleep(1500);
     
@@ -736,9 +768,9 @@ void showEndMenu() {
     settextstyle(36, 0, _T(""));
     
     char result[100];
-    if (gameStatus == GS_BLACK_WIN) {
+    if (game.status == GS_BLACK_WIN) {
         sprintf(result, "ڷʤ!");
-    } else if (gameStatus == GS_WHITE_WIN) {
+    } else if (game.status == GS_WHITE_WIN) {
         sprintf(result, "׷ʤ!");
     } else {
         sprintf(result, "ƽ!");
@@ -750,7 +782,7 @@ void showEndMenu() {
     settextstyle(24, 0, _T(""));
     settextcolor(BLACK);
     char stepInfo[50];
-    sprintf(stepInfo, "ܲ: %d", moveCount);
+    sprintf(stepInfo, "ܲ: %d", game.moveCount);
     outtextxy(350, 220, stepInfo);
     
     // ʾϷģʽ
@@ -760,6 +792,7 @@ void showEndMenu() {
         case GM_PVE_EASY: sprintf(modeInfo, "ģʽ: ˻ս()"); break;
         case GM_PVE_MEDIUM: sprintf(modeInfo, "ģʽ: ˻ս(е)"); break;
         case GM_PVE_HARD: sprintf(modeInfo, "ģʽ: ˻ս()"); break;
+        case GM_PVE_MCTS: sprintf(modeInfo, "ģʽ: ˻ս(ؿ)"); break;
     }
     outtextxy(350, 260, modeInfo);
     
@@ -770,7 +803,7 @@ void showEndMenu() {
     int optionsY = 350;
     int optionHeight = 50;
     
-    RECT endOptions[3];
+    RECT endOptions[4];
     
     // ¿ʼ
     endOptions[0].left = 250;
@@ -805,16 +838,36 @@ void showEndMenu() {
                   endOptions[2].right, endOptions[2].bottom, 10, 10);
     outtextxy(350, optionsY + 2 * optionHeight + 5, _T("˳Ϸ"));
     
+    // 壬صվǰ
+    endOptions[3].left = 250;
+    endOptions[3].top = optionsY + 3 * optionHeight;
+    endOptions[3].right = 550;
+    endOptions[3].bottom = optionsY + 3 * optionHeight + 40;
+    
+    setfillcolor(RGB(255, 218, 185));
+    fillroundrect(endOptions[3].left, endOptions[3].top, 
+                  endOptions[3].right, endOptions[3].bottom, 10, 10);
+    outtextxy(375, optionsY + 3 * optionHeight + 5, _T(""));
+    
     EndBatchDraw();
     
     // ȴѡ
     while (true) {
         MOUSEMSG msg = GetMouseMsg();
         if (msg.uMsg == WM_LBUTTONDOWN) {
-            for (int i = 0; i < 3; i++) {
+            for (int i = 0; i < 4; i++) {
                 if (msg.x >= endOptions[i].left && msg.x <= endOptions[i].right &&
                     msg.y >= endOptions[i].top && msg.y <= endOptions[i].bottom) {
                     
+                    // 뿪ǰȡڽеAI˼
+                    aiCancel();
+                    C6::ponderStop();
+                    
+                    // 뿪һʱд־ڽ˵£ͬһֻĽ
+                    if (i != 3) {
+                        saveGameLog();
+                    }
+                    
                     if (i == 0) {
                         // ¿ʼ
                         initBoard();
@@ -828,6 +881,10 @@ void showEndMenu() {
                     } else if (i == 2) {
                         // ˳Ϸ
                         exit(0);
+                    } else if (i == 3) {
+                        // صϷѭػ
+                        undoTurn();
+                        return;
                     }
                 }
             }
@@ -836,33 +893,30 @@ void showEndMenu() {
     }
 }
 
-int main() {
-    // ʼͼδ
-    initgraph(800, 600);
+// ֵϷѭ˵ʱ˳
+template <int N>
+void Gui<N>::run() {
+    initBoard();
+    showGameStartPrompt();
     
-    // 
-    srand((unsigned)time(NULL));
+    // ʼϷ
+    BeginBatchDraw();
+    drawBoardBackground();
+    drawGameInfo();
+    EndBatchDraw();
     
-    // ѭ
-    while (true) {
-        // ʾʼ˵
-        if (!gameStarted) {
-            showStartMenu();
-            
-            // ʼϷ
-            BeginBatchDraw();
-            drawBoardBackground();
-            drawGameInfo();
-            EndBatchDraw();
-        }
-        
+    while (gameStarted) {
         // Ϸ
-        if (gameStarted && gameStatus == GS_PLAYING) {
+        if (game.status == GS_PLAYING) {
+            // ȡغ̨AI˼Ⱥͽ
+            aiPoll();
+            
             // Ϣ
             if (MouseHit()) {
                 MOUSEMSG msg = GetMouseMsg();
                 
-                if (msg.uMsg == WM_LBUTTONDOWN) {
+                // AI˼ڼϵĵ
+                if (msg.uMsg == WM_LBUTTONDOWN && (gameMode == GM_PVP || game.currentPlayer == CT_BLACK)) {
                     // תΪ
                     int col = (msg.x - OFFSET + CELL_SIZE / 2) / CELL_SIZE;
                     int row = (msg.y - OFFSET + CELL_SIZE / 2) / CELL_SIZE;
@@ -870,44 +924,67 @@ int main() {
                     // 
                     if (row >= 0 && row < BOARD_SIZE && 
                         col >= 0 && col < BOARD_SIZE && 
-                        board[row][col] == CT_EMPTY) {
+                        C6::bitboardGet(&game.board.bits, row, col) == CT_EMPTY) {
                         
-                        makeMove(row, col, currentPlayer);
+                        makeMove(row, col, game.currentPlayer);
                         
-                        // ˻սģʽл
-                        if (gameStatus == GS_PLAYING) {
-                            if (gameMode == GM_PVP) {
-                                currentPlayer = (currentPlayer == CT_BLACK) ? CT_WHITE : CT_BLACK;
-                                drawGameInfo();
-                            } else {
-                                // ˻սģʽAIԶ
-                                currentPlayer = CT_WHITE;
-                                // ӳһ£ܿԼ
-                                Sleep(300);
+                        // ֻң˫ӹͬһ
+                        if (game.status == GS_PLAYING) {
+                            game.currentPlayer = stoneOwner(game.rule, game.moveCount);
+                            drawGameInfo();
+                            
+                            // ˻սģʽֵ׷ʱAIں̨ʼ˼
+                            if (gameMode != GM_PVP && game.currentPlayer == CT_WHITE) {
                                 aiMakeMove();
                             }
                         }
                     }
+                } else if (msg.uMsg == WM_RBUTTONDOWN) {
+                    undoTurn();
+                } else if (msg.uMsg == WM_MBUTTONDOWN) {
+                    redoTurn();
                 }
             }
         }
         
         // ϷǷ
-        if (gameStarted && gameStatus != GS_PLAYING) {
+        if (game.status != GS_PLAYING) {
             showEndMenu();
             
-            // Ϸ»ƽ
+            // Ϸ¿ʼ壩»ƽ
             if (gameStarted) {
-                BeginBatchDraw();
-                drawBoardBackground();
-                drawGameInfo();
-                EndBatchDraw();
+                redrawBoard();
             }
         }
         
         // ӳ٣CPUռ
         Sleep(10);
     }
+}
+
+int main() {
+    // ʼͼδ
+    initgraph(800, 600);
+    
+    // 
+    srand((unsigned)time(NULL));
+    
+    // ûCPU߳
+    ttResize(&tt, TT_DEFAULT_MB);
+    searchThreads = defaultSearchThreads();
+    
+    // ѭ
+    while (true) {
+        // ʾʼ˵
+        showStartMenu();
+        
+        // ѡ̴СӦϷѭ
+        if (boardSize == 19) {
+            Gui<19>::run();
+        } else {
+            Gui<15>::run();
+        }
+    }
     
     // رͼδ
     closegraph();